@@ -1,9 +1,36 @@
 #ifndef __IMAGES_H__
 #define __IMAGES_H__
-#endif
 
 #include "ece210_api.h"
 
+//run-length encoding of a sprite: each row is a list of run bytes ended by SPRITE_ROW_END, or a
+//single SPRITE_ROW_REPEAT if it is the same as the row above; a run byte skips some transparent
+//pixels (upper nibble) and then draws some opaque ones (lower nibble)
+#define SPRITE_ROW_END 0xF0				//ends a row (the rest of the row is transparent)
+#define SPRITE_ROW_REPEAT 0xF1			//the row is the same as the row above
+#define SPRITE_SKIP_SHIFT 4					//shift of the transparent pixels in a run byte
+#define SPRITE_DRAW_MASK 0x0F				//mask of the opaque pixels in a run byte
+#define SPRITE_MAX_SKIP 14					//most transparent pixels in one run byte (15 marks the control bytes) [pixels]
+#define SPRITE_MAX_DRAW 15					//most opaque pixels in one run byte [pixels]
+#define SPRITE_MAX_WIDTH 64					//widest sprite (a row fits in a 64-bit mask) [pixels]
+
+//image run-length encoded at build time (generated into Sprites.c by host/spritegen.c)
+struct SpriteData {
+	uint8_t width;								//width of the sprite [pixels]
+	uint8_t height;								//height of the sprite [pixels]
+	uint16_t color;								//RGB565 color of the opaque runs
+	const uint8_t *runs;					//run bytes, top row first
+};
+
+//structure for each entity's image
+struct Image {
+	uint8_t width;								//width of the image [pixels]
+	uint8_t height;								//height of the image [pixels]
+	uint16_t foregroundColor;			//foreground color of the image
+	uint16_t backgroundColor;			//background color of the image
+	const struct SpriteData *sprite;	//the image run-length encoded (background pixels are transparent)
+};
+
 extern const uint8_t FROG_BITMAP_UP[];
 #define FROG_BITMAP_UP_WIDTH 24
 #define FROG_BITMAP_UP_HEIGHT 18
@@ -46,3 +73,5 @@ extern const uint8_t LOG_BITMAP[];
 #define LOG_BITMAP_HEIGHT 25
 #define LOG_FOREGROUND_COLOR LCD_COLOR_BROWN
 #define LOG_BACKGROUND_COLOR LCD_COLOR_BLUE
+
+#endif
@@ -0,0 +1,212 @@
+//**************************************************
+//
+// Generated by host/spritegen.c from Images.c (make -C host sprites); do not edit
+//
+//**************************************************
+
+#include "Sprites.h"
+
+static const uint8_t FROG_UP_SPRITE_RUNS[] = {
+	0x22, 0x48, 0x42, 0xF0,
+	0xF1,
+	0x04, 0x2C, 0x24, 0xF0,
+	0x04, 0x23, 0x14, 0x13, 0x24, 0xF0,
+	0x22, 0x2C, 0x22, 0xF0,
+	0xF1,
+	0x2F, 0x05, 0xF0,
+	0xF1,
+	0x6C, 0xF0,
+	0xF1,
+	0x2F, 0x05, 0xF0,
+	0xF1,
+	0x22, 0x2C, 0x22, 0xF0,
+	0xF1,
+	0x04, 0x3A, 0x34, 0xF0,
+	0x04, 0x48, 0x44, 0xF0,
+	0x22, 0xE0, 0x22, 0xF0,
+	0xF1,
+};
+
+//49 bytes (54 as a bitmap)
+const struct SpriteData FROG_UP_SPRITE = {24, 18, 0x07E0, FROG_UP_SPRITE_RUNS};
+
+static const uint8_t FROG_RIGHT_SPRITE_RUNS[] = {
+	0x22, 0xA2, 0xF0,
+	0xF1,
+	0x08, 0x28, 0xF0,
+	0xF1,
+	0x62, 0x22, 0xF0,
+	0xF1,
+	0x4C, 0xF0,
+	0x3D, 0xF0,
+	0x2F, 0x01, 0xF0,
+	0x2C, 0x13, 0xF0,
+	0x2F, 0x01, 0xF0,
+	0xF1,
+	0xF1,
+	0xF1,
+	0x2C, 0x13, 0xF0,
+	0x2F, 0x01, 0xF0,
+	0x3D, 0xF0,
+	0x4C, 0xF0,
+	0x62, 0x22, 0xF0,
+	0xF1,
+	0x08, 0x28, 0xF0,
+	0xF1,
+	0x22, 0xA2, 0xF0,
+	0xF1,
+};
+
+//50 bytes (72 as a bitmap)
+const struct SpriteData FROG_RIGHT_SPRITE = {18, 24, 0x07E0, FROG_RIGHT_SPRITE_RUNS};
+
+static const uint8_t FROG_LEFT_SPRITE_RUNS[] = {
+	0x22, 0xA2, 0xF0,
+	0xF1,
+	0x08, 0x28, 0xF0,
+	0xF1,
+	0x62, 0x22, 0xF0,
+	0xF1,
+	0x2C, 0xF0,
+	0x2D, 0xF0,
+	0x0F, 0x01, 0xF0,
+	0x03, 0x1C, 0xF0,
+	0x0F, 0x01, 0xF0,
+	0xF1,
+	0xF1,
+	0xF1,
+	0x03, 0x1C, 0xF0,
+	0x0F, 0x01, 0xF0,
+	0x2D, 0xF0,
+	0x2C, 0xF0,
+	0x62, 0x22, 0xF0,
+	0xF1,
+	0x08, 0x28, 0xF0,
+	0xF1,
+	0x22, 0xA2, 0xF0,
+	0xF1,
+};
+
+//50 bytes (72 as a bitmap)
+const struct SpriteData FROG_LEFT_SPRITE = {18, 24, 0x07E0, FROG_LEFT_SPRITE_RUNS};
+
+static const uint8_t FROG_DOWN_SPRITE_RUNS[] = {
+	0x22, 0xE0, 0x22, 0xF0,
+	0xF1,
+	0x04, 0x48, 0x44, 0xF0,
+	0x04, 0x3A, 0x34, 0xF0,
+	0x22, 0x2C, 0x22, 0xF0,
+	0xF1,
+	0x2F, 0x05, 0xF0,
+	0xF1,
+	0x6C, 0xF0,
+	0xF1,
+	0x2F, 0x05, 0xF0,
+	0xF1,
+	0x22, 0x2C, 0x22, 0xF0,
+	0xF1,
+	0x04, 0x23, 0x14, 0x13, 0x24, 0xF0,
+	0x04, 0x2C, 0x24, 0xF0,
+	0x22, 0x48, 0x42, 0xF0,
+	0xF1,
+};
+
+//49 bytes (54 as a bitmap)
+const struct SpriteData FROG_DOWN_SPRITE = {24, 18, 0x07E0, FROG_DOWN_SPRITE_RUNS};
+
+//runs shared with FROG_UP_SPRITE
+const struct SpriteData FROG2_SPRITE = {24, 18, 0xF800, FROG_UP_SPRITE_RUNS};
+
+static const uint8_t CAR1_SPRITE_RUNS[] = {
+	0x88, 0xF0,
+	0x72, 0x62, 0xF0,
+	0x62, 0x82, 0xF0,
+	0x52, 0xA2, 0xF0,
+	0x3F, 0x03, 0xF0,
+	0x1F, 0x07, 0xF0,
+	0x0F, 0x09, 0xF0,
+	0xF1,
+	0xF1,
+	0xF1,
+	0x1F, 0x07, 0xF0,
+	0x31, 0x31, 0x81, 0x31, 0xF0,
+	0x43, 0xA3, 0xF0,
+};
+
+//34 bytes (39 as a bitmap)
+const struct SpriteData CAR1_SPRITE = {24, 13, 0x001F, CAR1_SPRITE_RUNS};
+
+static const uint8_t RACECAR_SPRITE_RUNS[] = {
+	0x38, 0x28, 0xF0,
+	0xF1,
+	0xF1,
+	0x62, 0x82, 0xF0,
+	0xF1,
+	0x3F, 0x03, 0xF0,
+	0x2F, 0x05, 0xF0,
+	0x1F, 0x07, 0xF0,
+	0x0F, 0x09, 0xF0,
+	0xF1,
+	0x1F, 0x07, 0xF0,
+	0x2F, 0x05, 0xF0,
+	0x3F, 0x03, 0xF0,
+	0x62, 0x82, 0xF0,
+	0xF1,
+	0x38, 0x28, 0xF0,
+	0xF1,
+	0xF1,
+};
+
+//40 bytes (54 as a bitmap)
+const struct SpriteData RACECAR_SPRITE = {24, 18, 0xF800, RACECAR_SPRITE_RUNS};
+
+static const uint8_t TRUCK_SPRITE_RUNS[] = {
+	0x88, 0xF0,
+	0x72, 0x62, 0xF0,
+	0x62, 0x82, 0xF0,
+	0x52, 0xA2, 0xF0,
+	0x3F, 0x03, 0xF0,
+	0x1F, 0x07, 0xF0,
+	0x0F, 0x09, 0xF0,
+	0xF1,
+	0xF1,
+	0xF1,
+	0x1F, 0x07, 0xF0,
+	0x31, 0x31, 0x81, 0x31, 0xF0,
+	0x43, 0xA3, 0xF0,
+};
+
+//34 bytes (39 as a bitmap)
+const struct SpriteData TRUCK_SPRITE = {24, 13, 0xFFFF, TRUCK_SPRITE_RUNS};
+
+static const uint8_t LOG_SPRITE_RUNS[] = {
+	0x0F, 0x0F, 0x0F, 0x0F, 0xF0,
+	0xF1,
+	0xF1,
+	0xF1,
+	0xF1,
+	0xF1,
+	0xF1,
+	0xF1,
+	0xF1,
+	0xF1,
+	0xF1,
+	0xF1,
+	0xF1,
+	0xF1,
+	0xF1,
+	0xF1,
+	0xF1,
+	0xF1,
+	0xF1,
+	0xF1,
+	0xF1,
+	0xF1,
+	0xF1,
+	0xF1,
+	0xF1,
+};
+
+//29 bytes (200 as a bitmap)
+const struct SpriteData LOG_SPRITE = {60, 25, 0xBBCA, LOG_SPRITE_RUNS};
+
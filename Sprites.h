@@ -0,0 +1,22 @@
+//**************************************************
+//
+// Generated by host/spritegen.c from Images.c (make -C host sprites); do not edit
+//
+//**************************************************
+
+#ifndef __SPRITES_H__
+#define __SPRITES_H__
+
+#include "Images.h"
+
+extern const struct SpriteData FROG_UP_SPRITE;
+extern const struct SpriteData FROG_RIGHT_SPRITE;
+extern const struct SpriteData FROG_LEFT_SPRITE;
+extern const struct SpriteData FROG_DOWN_SPRITE;
+extern const struct SpriteData FROG2_SPRITE;
+extern const struct SpriteData CAR1_SPRITE;
+extern const struct SpriteData RACECAR_SPRITE;
+extern const struct SpriteData TRUCK_SPRITE;
+extern const struct SpriteData LOG_SPRITE;
+
+#endif
@@ -0,0 +1,86 @@
+//**************************************************
+//
+// Authors: Caleb Reiter, Alex Fanner, Chris Chu, Kao Yang
+// Description: Background tile map of the playfield
+//
+// The playfield is a GRID_WIDTH by GRID_HEIGHT map of tiles surrounded by a
+// 1 pixel border. The renderer rebuilds every damaged pixel from this map
+// and the sprites on top of it, so nothing is ever erased to a guessed color.
+//
+//**************************************************
+
+#include "background.h"
+
+/***************************************************
+ * Global Variables
+ **************************************************/
+
+//color of each kind of tile
+static const uint16_t TILE_COLORS[] = {
+	LCD_COLOR_GREEN2,							//TILE_GRASS
+	LCD_COLOR_BLUE,								//TILE_WATER
+	LCD_COLOR_BLACK								//TILE_ROAD
+};
+
+static uint8_t tiles[GRID_HEIGHT][GRID_WIDTH];		//tile map of the playfield
+
+/***************************************************
+ * Functions
+ **************************************************/
+
+void backgroundInit(void) {
+	for (uint8_t row = 0; row < GRID_HEIGHT; row++) {
+		//grass on the first and last rows, water on the log rows and road on the car rows
+		uint8_t tile;
+		if (row == 0 || row == GRID_HEIGHT - 1) {
+			tile = TILE_GRASS;
+		} else if (row <= WATER_ROWS) {
+			tile = TILE_WATER;
+		} else {
+			tile = TILE_ROAD;
+		}
+		for (uint8_t col = 0; col < GRID_WIDTH; col++) {
+			tiles[row][col] = tile;
+		}
+	}
+} //end backgroundInit()
+
+uint8_t backgroundTile(uint8_t col, uint8_t row) {
+	return tiles[row][col];
+} //end backgroundTile()
+
+void backgroundFill(int16_t x, int16_t y, int16_t w, uint16_t *out) {
+	int16_t i = 0;
+
+	//rows outside the playfield
+	if (y < TOP_BORDER || y >= BOTTOM_BORDER) {
+		for (; i < w; i++) out[i] = OUTSIDE_COLOR;
+		return;
+	}
+
+	//top and bottom border rows
+	if (y == TOP_BORDER || y == BOTTOM_BORDER - 1) {
+		for (; i < w; i++) {
+			out[i] = (x + i < LEFT_BORDER || x + i >= RIGHT_BORDER) ? OUTSIDE_COLOR : BORDER_COLOR;
+		}
+		return;
+	}
+
+	uint8_t row = (y - TOP_BORDER) / GRID_SIZE;
+	while (i < w) {
+		int16_t px = x + i;
+		if (px < LEFT_BORDER || px >= RIGHT_BORDER) {
+			out[i++] = OUTSIDE_COLOR;
+		} else if (px == LEFT_BORDER || px == RIGHT_BORDER - 1) {
+			out[i++] = BORDER_COLOR;
+		} else {
+			//fill to the end of this tile (or the border) in one run
+			uint8_t col = (px - LEFT_BORDER) / GRID_SIZE;
+			int16_t end = LEFT_BORDER + (col + 1) * GRID_SIZE;
+			uint16_t color = TILE_COLORS[tiles[row][col]];
+			if (end > RIGHT_BORDER - 1) end = RIGHT_BORDER - 1;
+			if (end > x + w) end = x + w;
+			for (; x + i < end; i++) out[i] = color;
+		}
+	}
+} //end backgroundFill()
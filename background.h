@@ -0,0 +1,43 @@
+//**************************************************
+//
+// Authors: Caleb Reiter, Alex Fanner, Chris Chu, Kao Yang
+// Description: Background tile map of the playfield
+//
+//**************************************************
+
+#ifndef __BACKGROUND_H__
+#define __BACKGROUND_H__
+
+#include "ece210_api.h"
+#include "layout.h"
+
+//kinds of background tile
+#define TILE_GRASS 0					//safe grass (top and bottom rows)
+#define TILE_WATER 1					//water (log rows)
+#define TILE_ROAD 2						//road (car rows)
+
+#define BORDER_COLOR LCD_COLOR_GRAY				//color of the 1 pixel border around the playfield
+#define OUTSIDE_COLOR LCD_COLOR_BLACK			//color of the screen outside the playfield
+
+/* Builds the GRID_WIDTH by GRID_HEIGHT tile map from the playfield layout */
+void backgroundInit(void);
+
+/* Returns the tile at a grid location
+ * Parameters:
+ * 	-col: grid column [0, GRID_WIDTH)
+ * 	-row: grid row [0, GRID_HEIGHT)
+ * Returns:
+ * 	-one of TILE_GRASS, TILE_WATER, TILE_ROAD
+ */
+uint8_t backgroundTile(uint8_t col, uint8_t row);
+
+/* Fills a horizontal span of pixels with the background (tiles, border and outside area)
+ * Parameters:
+ * 	-x: x position of the first pixel [pixels]
+ * 	-y: y position of the span [pixels]
+ * 	-w: number of pixels
+ * 	-*out: receives w RGB565 pixels
+ */
+void backgroundFill(int16_t x, int16_t y, int16_t w, uint16_t *out);
+
+#endif
@@ -0,0 +1,68 @@
+//**************************************************
+//
+// Authors: Caleb Reiter, Alex Fanner, Chris Chu, Kao Yang
+// Description: Millisecond clock driven by SysTick
+//
+// The board library does not use SysTick (its delays are busy loops), so the
+// game owns it. On the host simulator the clock reads the virtual time and
+// waiting advances it, which the simulator reports as slack.
+//
+//**************************************************
+
+#include "clock.h"
+
+#ifdef HOST_SIM
+#include "ece210_sim.h"
+#endif
+
+/***************************************************
+ * Global Variables
+ **************************************************/
+
+#ifndef HOST_SIM
+static volatile uint32_t clockTicks = 0;				//milliseconds since clockInit()
+#endif
+
+/***************************************************
+ * Functions
+ **************************************************/
+
+#ifdef HOST_SIM
+
+void clockInit(void) {
+} //end clockInit()
+
+uint32_t clockMs(void) {
+	return simTimeUs() / 1000;
+} //end clockMs()
+
+void clockWaitUntil(uint32_t ms) {
+	uint64_t target = (uint64_t)ms * 1000;
+	if (target > simTimeUs()) simIdleUs(target - simTimeUs());
+} //end clockWaitUntil()
+
+#else
+
+void SysTick_Handler(void) {
+	clockTicks++;
+} //end SysTick_Handler()
+
+void clockInit(void) {
+	SysTick->CTRL = 0;
+	SysTick->LOAD = CLOCK_CPU_HZ / 1000 - 1;
+	SysTick->VAL = 0;
+	SysTick->CTRL = SysTick_CTRL_CLKSOURCE_Msk | SysTick_CTRL_TICKINT_Msk | SysTick_CTRL_ENABLE_Msk;
+} //end clockInit()
+
+uint32_t clockMs(void) {
+	return clockTicks;
+} //end clockMs()
+
+void clockWaitUntil(uint32_t ms) {
+	//sleep between SysTick interrupts until the time comes
+	while ((int32_t)(ms - clockTicks) > 0) {
+		__WFI();
+	}
+} //end clockWaitUntil()
+
+#endif
@@ -0,0 +1,27 @@
+//**************************************************
+//
+// Authors: Caleb Reiter, Alex Fanner, Chris Chu, Kao Yang
+// Description: Millisecond clock driven by SysTick
+//
+//**************************************************
+
+#ifndef __CLOCK_H__
+#define __CLOCK_H__
+
+#include "ece210_api.h"
+
+#define CLOCK_CPU_HZ 80000000				//core clock the board library runs the CPU at [Hz]
+
+/* Starts the millisecond clock (SysTick interrupt every 1 ms) */
+void clockInit(void);
+
+/* Returns the time since clockInit() [milliseconds] (wraps after about 49 days) */
+uint32_t clockMs(void);
+
+/* Sleeps until the clock reaches a time; returns right away if it already has
+ * Parameters:
+ * 	-ms: time to wait for [milliseconds]
+ */
+void clockWaitUntil(uint32_t ms);
+
+#endif
@@ -0,0 +1,94 @@
+//**************************************************
+//
+// Authors: Caleb Reiter, Alex Fanner, Chris Chu, Kao Yang
+// Description: Lane-indexed collision queries over the entity store
+//
+// Each lane keeps its entities sorted by left edge. No entity is wider than
+// its lane's widest, so every entity touching a span starts less than that
+// width to the left of it: a binary search finds the first candidate and the
+// scan stops at the first entity that starts past the span. Entities never
+// straddle the border (cars wrap by jumping to the other side), so a wrap is
+// just an entity changing places in the sort order. Entities as far right as
+// each other are sorted by index, so the order follows from the positions
+// alone and a rollback can sort a lane afresh without changing which log a
+// frog rides.
+//
+//**************************************************
+
+#include "collision.h"
+
+/***************************************************
+ * Helper Functions
+ **************************************************/
+
+/* Returns the first position in a lane whose entity's left edge plus the lane's widest
+ * entity reaches x (binary search)
+ */
+static uint8_t lowerBound(const struct CollisionLanes *lanes, const struct EntityStore *store, uint8_t lane, int16_t x) {
+	uint8_t low = store->laneStart[lane], high = store->laneStart[lane + 1];
+
+	while (low < high) {
+		uint8_t mid = (low + high) / 2;
+		if (store->xpos[lanes->order[mid]] + lanes->maxWidth[lane] < x) {
+			low = mid + 1;
+		} else {
+			high = mid;
+		}
+	}
+	return low;
+}
+
+/* Returns true if entity a belongs after entity b in its lane: further right, or as far right and a later index */
+static bool sortsAfter(const struct EntityStore *store, uint8_t a, uint8_t b) {
+	return store->xpos[a] > store->xpos[b] || (store->xpos[a] == store->xpos[b] && a > b);
+}
+
+/***************************************************
+ * Functions
+ **************************************************/
+
+void collisionBuild(struct CollisionLanes *lanes, const struct EntityStore *store) {
+	for (uint8_t lane = 0; lane < ENTITY_ROWS; lane++) {
+		lanes->maxWidth[lane] = 0;
+		for (uint8_t i = store->laneStart[lane]; i < store->laneStart[lane + 1]; i++) {
+			uint8_t width = SPRITE_IMAGES[store->sprite[i]].width;
+			if (width > lanes->maxWidth[lane]) lanes->maxWidth[lane] = width;
+			lanes->order[i] = i;
+		}
+	}
+	collisionUpdate(lanes, store);
+} //end collisionBuild()
+
+void collisionUpdate(struct CollisionLanes *lanes, const struct EntityStore *store) {
+	//insertion sort of each lane: linear when the order did not change
+	for (uint8_t lane = 0; lane < ENTITY_ROWS; lane++) {
+		uint8_t start = store->laneStart[lane];
+		for (uint8_t i = start + 1; i < store->laneStart[lane + 1]; i++) {
+			uint8_t entity = lanes->order[i];
+			uint8_t j = i;
+			while (j > start && sortsAfter(store, lanes->order[j - 1], entity)) {
+				lanes->order[j] = lanes->order[j - 1];
+				j--;
+			}
+			lanes->order[j] = entity;
+		}
+	}
+} //end collisionUpdate()
+
+int8_t collisionOverlap(const struct CollisionLanes *lanes, const struct EntityStore *store, uint8_t lane, uint8_t left, uint8_t right) {
+	for (uint8_t k = lowerBound(lanes, store, lane, left); k < store->laneStart[lane + 1]; k++) {
+		uint8_t entity = lanes->order[k];
+		if (store->xpos[entity] > right) break;
+		if (store->xpos[entity] + SPRITE_IMAGES[store->sprite[entity]].width >= left) return entity;
+	}
+	return COLLISION_NONE;
+} //end collisionOverlap()
+
+int8_t collisionCover(const struct CollisionLanes *lanes, const struct EntityStore *store, uint8_t lane, uint8_t left, uint8_t right) {
+	for (uint8_t k = lowerBound(lanes, store, lane, right); k < store->laneStart[lane + 1]; k++) {
+		uint8_t entity = lanes->order[k];
+		if (store->xpos[entity] > left) break;
+		if (store->xpos[entity] + SPRITE_IMAGES[store->sprite[entity]].width >= right) return entity;
+	}
+	return COLLISION_NONE;
+} //end collisionCover()
@@ -0,0 +1,60 @@
+//**************************************************
+//
+// Authors: Caleb Reiter, Alex Fanner, Chris Chu, Kao Yang
+// Description: Lane-indexed collision queries over the entity store
+//
+//**************************************************
+
+#ifndef __COLLISION_H__
+#define __COLLISION_H__
+
+#include "entities.h"
+
+#define COLLISION_NONE -1						//no entity answers the query
+
+//entities of every lane sorted by left edge (then by index, so the order follows from the positions alone)
+struct CollisionLanes {
+	uint8_t order[MAX_ENTITIES];				//entity indexes sorted by x position within each lane (lanes use the store's laneStart ranges)
+	uint8_t maxWidth[ENTITY_ROWS];			//widest entity of each lane [pixels]
+};
+
+/* Sorts every lane of a freshly filled entity store
+ * Parameters:
+ * 	-*lanes: the lanes to build
+ * 	-*store: the entities
+ */
+void collisionBuild(struct CollisionLanes *lanes, const struct EntityStore *store);
+
+/* Restores the sort order after the entities moved; entities that only slid keep their
+ * order and cost one comparison each, an entity that wrapped around moves to the other end
+ * Parameters:
+ * 	-*lanes: the lanes to update
+ * 	-*store: the entities
+ */
+void collisionUpdate(struct CollisionLanes *lanes, const struct EntityStore *store);
+
+/* Finds an entity in a lane that overlaps a span (both ends inclusive)
+ * Parameters:
+ * 	-*lanes: the sorted lanes
+ * 	-*store: the entities
+ * 	-lane: the lane to search [0, ENTITY_ROWS)
+ * 	-left: left end of the span [pixels]
+ * 	-right: right end of the span [pixels]
+ * Returns:
+ * 	-the index of the overlapping entity, or COLLISION_NONE
+ */
+int8_t collisionOverlap(const struct CollisionLanes *lanes, const struct EntityStore *store, uint8_t lane, uint8_t left, uint8_t right);
+
+/* Finds an entity in a lane that covers a whole span (both ends inclusive)
+ * Parameters:
+ * 	-*lanes: the sorted lanes
+ * 	-*store: the entities
+ * 	-lane: the lane to search [0, ENTITY_ROWS)
+ * 	-left: left end of the span [pixels]
+ * 	-right: right end of the span [pixels]
+ * Returns:
+ * 	-the index of the covering entity, or COLLISION_NONE
+ */
+int8_t collisionCover(const struct CollisionLanes *lanes, const struct EntityStore *store, uint8_t lane, uint8_t left, uint8_t right);
+
+#endif
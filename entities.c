@@ -0,0 +1,144 @@
+//**************************************************
+//
+// Authors: Caleb Reiter, Alex Fanner, Chris Chu, Kao Yang
+// Description: Lane entity store (logs and cars) and sprite table
+//
+// Entities are kept as parallel arrays rather than an array of structs so the
+// per-tick passes walk each field linearly and nothing is copied by value;
+// an entity's image is a one byte index into SPRITE_IMAGES.
+//
+// Positions are worked out from the tick rather than stepped. A car keeps its
+// speed and wraps around a track of fixed length, so its position is its
+// phase plus speed times ticks, wrapped, and it comes back to the same spot
+// every track / gcd(track, speed) ticks. A log keeps its speed from one
+// bounce to the next, so its position is closed form in between, and the
+// tick of its next bounce is one division away. The speed it bounces off with
+// is drawn from the generator at a counter given by the tick and the log
+// (prngJump), not the next number in line, so no draw depends on the order
+// entities are moved in and a log can be moved many ticks at once.
+//
+//**************************************************
+
+#include "entities.h"
+#include "Sprites.h"
+
+#define TRACK_START ((LEFT_BORDER + 1) << FIXED_SHIFT)		//leftmost position of an entity, Q8.8 fixed point [1/256 pixels]
+
+/***************************************************
+ * Global Constants
+ **************************************************/
+
+const struct Image SPRITE_IMAGES[NUM_SPRITES] = {
+	{CAR1_BITMAP_WIDTH, CAR1_BITMAP_HEIGHT, CAR1_FOREGROUND_COLOR, CAR1_BACKGROUND_COLOR, &CAR1_SPRITE},										//SPRITE_CAR1
+	{RACECAR_BITMAP_WIDTH, RACECAR_BITMAP_HEIGHT, RACECAR_FOREGROUND_COLOR, RACECAR_BACKGROUND_COLOR, &RACECAR_SPRITE},			//SPRITE_RACECAR
+	{TRUCK_BITMAP_WIDTH, TRUCK_BITMAP_HEIGHT, TRUCK_FOREGROUND_COLOR, TRUCK_BACKGROUND_COLOR, &TRUCK_SPRITE},								//SPRITE_TRUCK
+	{LOG_BITMAP_WIDTH, LOG_BITMAP_HEIGHT, LOG_FOREGROUND_COLOR, LOG_BACKGROUND_COLOR, &LOG_SPRITE},													//SPRITE_LOG
+	{FROG_BITMAP_UP_WIDTH, FROG_BITMAP_UP_HEIGHT, FROG_FOREGROUND_COLOR, FROG_BACKGROUND_COLOR, &FROG_UP_SPRITE},						//SPRITE_FROG_UP
+	{FROG_BITMAP_RIGHT_WIDTH, FROG_BITMAP_RIGHT_HEIGHT, FROG_FOREGROUND_COLOR, FROG_BACKGROUND_COLOR, &FROG_RIGHT_SPRITE},	//SPRITE_FROG_RIGHT
+	{FROG_BITMAP_LEFT_WIDTH, FROG_BITMAP_LEFT_HEIGHT, FROG_FOREGROUND_COLOR, FROG_BACKGROUND_COLOR, &FROG_LEFT_SPRITE},			//SPRITE_FROG_LEFT
+	{FROG_BITMAP_DOWN_WIDTH, FROG_BITMAP_DOWN_HEIGHT, FROG_FOREGROUND_COLOR, FROG_BACKGROUND_COLOR, &FROG_DOWN_SPRITE},			//SPRITE_FROG_DOWN
+	{FROG_BITMAP_UP_WIDTH, FROG_BITMAP_UP_HEIGHT, FROG2_FOREGROUND_COLOR, FROG2_BACKGROUND_COLOR, &FROG2_SPRITE}						//SPRITE_FROG2
+};
+
+/***************************************************
+ * Helper Functions
+ **************************************************/
+
+/* Returns the length of the track a car wraps around on, from LEFT_BORDER + 1 to RIGHT_BORDER - width - 1, Q8.8 [1/256 pixels] */
+static uint32_t carTrack(uint8_t width) {
+	return (uint32_t)(RIGHT_BORDER - width - 1 - LEFT_BORDER) << FIXED_SHIFT;
+}
+
+/* Returns a car's position on a tick, Q8.8 [1/256 pixels]: a car runs around its track for good, so its
+ * position is its phase on tick 0 plus the distance covered, wrapped around the track */
+static uint32_t carAt(uint16_t origin, uint16_t speed, uint8_t direction, uint8_t width, uint32_t tick) {
+	uint32_t track = carTrack(width);
+	uint32_t phase = origin - TRACK_START;
+	//(speed * tick) % track without overflowing for long games
+	uint32_t covered = speed * (tick % track) % track;
+
+	//both are under a track, so one subtraction wraps their sum around
+	phase = direction == PS2_RIGHT ? phase + covered : phase + track - covered;
+	if (phase >= track) phase -= track;
+	return TRACK_START + phase;
+}
+
+/* Returns a log's position some ticks after its last bounce (before its next one), Q8.8 [1/256 pixels] */
+static uint16_t logAt(uint16_t origin, uint16_t speed, uint8_t direction, uint32_t ticks) {
+	return direction == PS2_RIGHT ? origin + speed * ticks : origin - speed * ticks;
+}
+
+/* Returns the ticks after its last bounce on which a log reaches a border: the right edge at RIGHT_BORDER
+ * or the left edge at LEFT_BORDER (at least 1) [ticks] */
+static uint32_t logBounce(uint16_t origin, uint16_t speed, uint8_t direction, uint8_t width) {
+	if (direction == PS2_RIGHT) {
+		uint16_t limit = (RIGHT_BORDER - width) << FIXED_SHIFT;
+		return origin + speed >= limit ? 1 : (limit - origin + speed - 1) / speed;
+	}
+	return origin < TRACK_START ? 1 : (origin - TRACK_START) / speed + 1;
+}
+
+/* Returns the speed a log bounces off a border with; it follows from the generator, the log and the tick
+ * alone, so a log's path can be worked out from any point of it */
+static uint16_t bounceSpeed(const struct Prng *rng, uint8_t i, uint32_t tick) {
+	struct Prng draw = *rng;
+	prngJump(&draw, tick * MAX_ENTITIES + i);
+	return randSpeed(&draw, LOG_MIN_SPEED, LOG_MAX_SPEED);
+}
+
+/***************************************************
+ * Functions
+ **************************************************/
+
+void entitiesAt(struct EntityStore *store, const struct Prng *rng, uint32_t tick) {
+	for (uint8_t i = 0; i < store->count; i++) {
+		uint8_t width = SPRITE_IMAGES[store->sprite[i]].width;
+		uint32_t x;
+
+		if (store->sprite[i] == SPRITE_LOG) {
+			//take every bounce up to the tick, then slide from the last one
+			uint16_t elapsed = tick - store->since[i];
+			uint32_t bounce;
+			while ((bounce = logBounce(store->origin[i], store->speed[i], store->direction[i], width)) <= elapsed) {
+				store->origin[i] = logAt(store->origin[i], store->speed[i], store->direction[i], bounce);
+				//step back off the border, keeping the sub-pixel part
+				store->origin[i] += store->direction[i] == PS2_RIGHT ? -(1 << FIXED_SHIFT) : (1 << FIXED_SHIFT);
+				store->direction[i] = store->direction[i] == PS2_RIGHT ? PS2_LEFT : PS2_RIGHT;
+				store->speed[i] = bounceSpeed(rng, i, tick - elapsed + bounce);
+				store->since[i] += bounce;
+				elapsed -= bounce;
+			}
+			x = logAt(store->origin[i], store->speed[i], store->direction[i], elapsed);
+		} else {
+			x = carAt(store->origin[i], store->speed[i], store->direction[i], width, tick);
+		}
+
+		store->xpos[i] = x >> FIXED_SHIFT;
+		store->xfrac[i] = x & FIXED_FRACTION;
+	}
+} //end entitiesAt()
+
+void slide(uint8_t *xpos, uint8_t *xfrac, uint16_t speed, uint8_t direction) {
+	//position as Q8.8 fixed point
+	int32_t x = ((int32_t)*xpos << FIXED_SHIFT) + *xfrac;
+	x += (direction == PS2_LEFT ? -(int32_t)speed : (int32_t)speed);
+	//only the whole pixel part reaches the screen
+	*xpos = x >> FIXED_SHIFT;
+	*xfrac = x & FIXED_FRACTION;
+} //end slide()
+
+uint8_t randRange(struct Prng *rng, uint8_t start, uint8_t end) {
+	return start + prngBelow(rng, end - start);
+} //end randRange()
+
+uint16_t randSpeed(struct Prng *rng, uint16_t min, uint16_t max) {
+	return min + prngBelow(rng, max - min + 1);
+} //end randSpeed()
+
+uint8_t xOffset(uint8_t sprite) {
+	return (GRID_SIZE - SPRITE_IMAGES[sprite].width) / 2;
+} //end xOffset()
+
+uint8_t yOffset(uint8_t sprite) {
+	return (GRID_SIZE - SPRITE_IMAGES[sprite].height) / 2;
+} //end yOffset()
@@ -0,0 +1,114 @@
+//**************************************************
+//
+// Authors: Caleb Reiter, Alex Fanner, Chris Chu, Kao Yang
+// Description: Lane entity store (logs and cars) and sprite table
+//
+//**************************************************
+
+#ifndef __ENTITIES_H__
+#define __ENTITIES_H__
+
+#include "ece210_api.h"
+#include "Images.h"
+#include "layout.h"
+#include "prng.h"
+
+#define LOGS_PER_ROW 1							//number of logs per water row [number of logs]
+#define MAX_ENTITIES_PER_ROW 3  		//maximum number of non-player entities per row [number of entities]
+#define MAX_ENTITIES ((ENTITY_ROWS) * MAX_ENTITIES_PER_ROW)		//size of the entity store [number of entities]
+
+#define FIXED_SHIFT 8						//number of fraction bits in Q8.8 fixed point values [bits]
+#define FIXED_FRACTION 0xFF			//mask of the fraction bits of a Q8.8 fixed point value
+
+#define LOG_MIN_SPEED 0x0040		//minimum speed of logs, Q8.8 (0.25 pixels per tick) [1/256 pixels]
+#define LOG_MAX_SPEED 0x0180		//maximum speed of logs, Q8.8 (1.5 pixels per tick) [1/256 pixels]
+#define CAR_MIN_SPEED 0x0040		//minimum speed of cars, Q8.8 (0.25 pixels per tick) [1/256 pixels]
+#define CAR_MAX_SPEED 0x0200		//maximum speed of cars, Q8.8 (2 pixels per tick) [1/256 pixels]
+
+//sprite ids (indexes into SPRITE_IMAGES)
+#define SPRITE_CAR1 0
+#define SPRITE_RACECAR 1
+#define SPRITE_TRUCK 2
+#define SPRITE_LOG 3
+#define SPRITE_FROG_UP 4
+#define SPRITE_FROG_RIGHT 5
+#define SPRITE_FROG_LEFT 6
+#define SPRITE_FROG_DOWN 7
+#define SPRITE_FROG2 8
+#define NUM_SPRITES 9
+#define NUM_CAR_SPRITES 3						//car sprites are the first ids [number of sprites]
+
+//every image the game draws, indexed by sprite id
+extern const struct Image SPRITE_IMAGES[NUM_SPRITES];
+
+//every non-player entity as parallel arrays, stored lane by lane
+struct EntityStore {
+	uint8_t count;														//number of entities in the store
+	uint8_t laneStart[ENTITY_ROWS + 1];				//index of the first entity of each lane (laneStart[ENTITY_ROWS] == count)
+	uint8_t xpos[MAX_ENTITIES];								//x position of each entity [pixels]
+	uint8_t xfrac[MAX_ENTITIES];							//sub-pixel part of each x position [1/256 pixels]
+	uint16_t origin[MAX_ENTITIES];						//position a car had on tick 0, or a log after its last bounce, Q8.8 fixed point [1/256 pixels]
+	uint16_t since[MAX_ENTITIES];							//tick of each log's last bounce (low 16 bits; 0 for cars) [ticks]
+	uint16_t ypos[MAX_ENTITIES];							//y position of each entity [pixels]
+	uint16_t speed[MAX_ENTITIES];							//distance each entity moves every tick, Q8.8 fixed point [1/256 pixels]
+	uint8_t direction[MAX_ENTITIES];					//direction of each entity [one of PS2_RIGHT, PS2_LEFT]
+	uint8_t lane[MAX_ENTITIES];								//lane of each entity (0 is the top water row) [rows]
+	uint8_t sprite[MAX_ENTITIES];							//sprite id of each entity
+};
+
+/* Moves every entity to where it is on a tick: a car wraps around its lane for good, so its position
+ * follows from the tick alone; a log slides from its last bounce, taking the bounces on the way first
+ * (a log may not be moved by 65536 ticks or more at once)
+ * Parameters:
+ * 	-*store: the entities to move
+ * 	-*rng: the random number generator the bounce speeds follow from (left untouched)
+ * 	-tick: the tick, no earlier than any log's last bounce [ticks]
+ */
+void entitiesAt(struct EntityStore *store, const struct Prng *rng, uint32_t tick);
+
+/* Moves an x position sideways by a sub-pixel distance
+ * Parameters:
+ * 	-*xpos: whole pixel part of the position [pixels]
+ * 	-*xfrac: sub-pixel part of the position [1/256 pixels]
+ * 	-speed: distance to move, Q8.8 fixed point [1/256 pixels]
+ * 	-direction: direction to move [one of PS2_RIGHT, PS2_LEFT]
+ */
+void slide(uint8_t *xpos, uint8_t *xfrac, uint16_t speed, uint8_t direction);
+
+/* Generate a random number in the given range (inclusive-exclusive)
+ * Parameters:
+ * 	-*rng: the random number generator
+ * 	-start: start of the range
+ * 	-end: end of the range
+ * Returns:
+ * 	-a random number in the range
+ */
+uint8_t randRange(struct Prng *rng, uint8_t start, uint8_t end);
+
+/* Generate a random speed in the given range (inclusive)
+ * Parameters:
+ * 	-*rng: the random number generator
+ * 	-min: slowest speed, Q8.8 fixed point [1/256 pixels per tick]
+ * 	-max: fastest speed, Q8.8 fixed point [1/256 pixels per tick]
+ * Returns:
+ * 	-a random speed in the range
+ */
+uint16_t randSpeed(struct Prng *rng, uint16_t min, uint16_t max);
+
+/* Calculate the x offset to render a sprite in the horizontal center of each grid location
+ * Parameters:
+ * 	-sprite: the sprite id
+ * Returns:
+ * 	-the x offset of the sprite [pixels]
+ */
+uint8_t xOffset(uint8_t sprite);
+
+/* Calculate the y offset to render a sprite in the vertical center of each grid location
+ * Parameters:
+ * 	-sprite: the sprite id
+ * Returns:
+ * 	-the y offset of the sprite [pixels]
+ */
+uint8_t yOffset(uint8_t sprite);
+
+#endif
@@ -0,0 +1,223 @@
+//**************************************************
+//
+// Authors: Caleb Reiter, Alex Fanner, Chris Chu, Kao Yang
+// Description: Game state and simulation (no input, radio or drawing)
+//
+// Everything a tick changes lives in struct Game and every random draw comes
+// from its own generator, so a game is a pure function of its seed and the
+// players' inputs. Boards that agree on the seed and exchange inputs run
+// identical games (see lockstep.c).
+//
+//**************************************************
+
+#include "game.h"
+#include "profile.h"
+
+/***************************************************
+ * Helper Functions
+ **************************************************/
+
+/* Corrects the x and y offset of a player based on its image */
+static void correctOffset(struct Player *player) {
+	//drop any sub-pixel position picked up riding a log
+	player->xfrac = 0;
+	//set position to top left of grid location
+	player->xpos = ((player->xpos - LEFT_BORDER) / GRID_SIZE) * GRID_SIZE + LEFT_BORDER;
+	player->ypos = ((player->ypos - TOP_BORDER) / GRID_SIZE) * GRID_SIZE + TOP_BORDER;
+	
+	//column the player is in
+	uint8_t gridx = (player->xpos - LEFT_BORDER) / GRID_SIZE;
+	//x position of the left side of the column
+	uint8_t leftx = gridx * GRID_SIZE + LEFT_BORDER;
+	//x position of the right side of the column
+	uint8_t rightx = (gridx + 1) * GRID_SIZE + LEFT_BORDER;
+	//if the player is closer to the right column, set position to right side of column;
+	//else, set position to left side of column
+	if (player->xpos - leftx > rightx - player->xpos) {
+		player->xpos = rightx;
+	} else {
+		player->xpos = leftx;
+	}
+	//offset position
+	player->xpos += xOffset(player->sprite);
+	player->ypos += yOffset(player->sprite);
+}
+
+/* Determines whether a move is valid based on the player's current position and planned move */
+static bool isValidMove(const struct Player *player, uint8_t direction) {
+	const struct Image *image = &SPRITE_IMAGES[player->sprite];
+
+	//return false if player's move exceeds boundaries based on the move direction
+	switch(direction) {
+		case PS2_RIGHT:
+			if (player->xpos + image->width + player->move > RIGHT_BORDER) return false;
+			break;
+		case PS2_UP:
+			if (player->ypos - player->move < TOP_BORDER) return false;
+			break;
+		case PS2_LEFT:
+			if (player->xpos - player->move < LEFT_BORDER) return false;
+			break;
+		case PS2_DOWN:
+			if (player->ypos + image->height + player->move > BOTTOM_BORDER) return false;
+			break;
+	}
+	
+	//return true if the player can make the desired move
+	return true;
+	
+} //end isValidMove()
+
+/* Moves a player one hop in its current direction */
+static void movePlayer(struct Player *player) {
+	//only move if the player's move is valid
+	if (isValidMove(player, player->direction)) {
+		
+		//change player image to indicate direction
+		switch(player->direction) {
+			case PS2_RIGHT:
+				player->sprite = SPRITE_FROG_RIGHT; break;
+			case PS2_UP:
+				player->sprite = SPRITE_FROG_UP; break;
+			case PS2_LEFT:
+				player->sprite = SPRITE_FROG_LEFT; break;
+			case PS2_DOWN:
+				player->sprite = SPRITE_FROG_DOWN; break;
+		}
+		
+		//correct offset for new image if not in the water or if moving left/right
+		if (player->ypos >= TOP_BORDER + GRID_SIZE * WATER_ROWS
+				|| player->direction == PS2_RIGHT
+				|| player->direction == PS2_LEFT) {
+					correctOffset(player);
+		}
+		
+		//move player based on current direction
+		switch(player->direction) {
+			case PS2_RIGHT:
+				player->xpos += player->move; break;
+			case PS2_UP:
+				player->ypos -= player->move; break;
+			case PS2_LEFT:
+				player->xpos -= player->move; break;
+			case PS2_DOWN:
+				player->ypos += player->move;	break;
+		}
+		
+	//if the player tries to make an invalid move
+	} else {
+		//the local board flashes its lights
+		player->blocked = true;
+	}
+} //end movePlayer()
+
+/* Updates player's position based on its input */
+static void updatePlayer(struct Player *player, uint8_t input) {
+	//if no directional input, reset move variable; else, if the player can move, move player
+	if (input == PS2_CENTER) {
+		//allow player to move again
+		player->canMove = true;
+	} else if (player->canMove) {
+		//prevent player from making further moves until no input is detected
+		player->canMove = false;
+		//update player's direction variable
+		player->direction = input;
+		//move the player
+		movePlayer(player);
+	}
+} //end updatePlayer()
+
+/* Checks what the player stands on: a car kills it, a log carries it, open water drowns it */
+static void checkPlayer(struct Game *game, struct Player *player) {
+	//calculate player's current row, leftmost position, and rightmost position
+	uint8_t row = (player->ypos - TOP_BORDER) / GRID_SIZE;
+	uint8_t f_left = player->xpos;
+	uint8_t f_right = player->xpos + SPRITE_IMAGES[player->sprite].width;
+
+	//only check for collisions if the player is not on the first or last row
+	if (row != GRID_HEIGHT - 1 && row != 0) {
+		//if the player is not in a water row
+		if (row > WATER_ROWS) {
+			//the player is hit by any car overlapping it (including one that covers it completely)
+			if (collisionOverlap(&game->lanes, &game->entities, row - 1, f_left, f_right) != COLLISION_NONE) {
+				player->status = PLAYER_DEAD;
+			}
+		} else {
+			//the player rides the log it is standing on, and drowns if there is none
+			int8_t log = collisionCover(&game->lanes, &game->entities, row - 1, f_left, f_right);
+			if (log != COLLISION_NONE) {
+				slide(&player->xpos, &player->xfrac, game->entities.speed[log], game->entities.direction[log]);
+			} else {
+				player->status = PLAYER_DEAD;
+			}
+		}
+	}
+
+	//check for a winner
+	if (player->status == PLAYER_PLAYING && player->ypos < TOP_BORDER + GRID_SIZE) {
+		player->status = PLAYER_WON;
+	}
+} //end checkPlayer()
+
+/***************************************************
+ * Functions
+ **************************************************/
+
+void gameStart(struct Game *game, uint32_t seed, uint8_t numPlayers, const struct Level *level) {
+	struct Prng starts;
+
+	game->tick = 0;
+	game->numPlayers = numPlayers;
+	//the level comes from stream 0 of the seed and start positions from stream 1, so the level follows from the
+	//seed and difficulty alone; the logs bounce with the speeds its search saw
+	game->rng = level->rng;
+	prngStream(&starts, seed, 1);
+	levelFill(&game->entities, level);
+	collisionBuild(&game->lanes, &game->entities);
+
+	//every player starts facing up in a random column of the bottom row
+	for (uint8_t i = 0; i < game->numPlayers; i++) {
+		struct Player *player = &game->players[i];
+		player->move = GRID_SIZE;
+		player->direction = PS2_UP;
+		player->sprite = SPRITE_FROG_UP;
+		player->xpos = LEFT_BORDER + randRange(&starts, 0, GRID_WIDTH) * GRID_SIZE + xOffset(player->sprite);
+		player->xfrac = 0;
+		player->ypos = TOP_BORDER + ((GRID_HEIGHT - 1) * GRID_SIZE) + yOffset(player->sprite);
+		player->canMove = true;
+		player->blocked = false;
+		player->status = PLAYER_PLAYING;
+	}
+} //end gameStart()
+
+void gameStep(struct Game *game, const uint8_t inputs[GAME_MAX_PLAYERS]) {
+	//update non-player entities
+	PROFILE_BEGIN(PROFILE_ENTITIES);
+	entitiesAt(&game->entities, &game->rng, game->tick + 1);
+	PROFILE_END(PROFILE_ENTITIES);
+	PROFILE_BEGIN(PROFILE_LANES);
+	collisionUpdate(&game->lanes, &game->entities);
+	PROFILE_END(PROFILE_LANES);
+
+	//update every player still playing
+	PROFILE_BEGIN(PROFILE_PLAYERS);
+	for (uint8_t i = 0; i < game->numPlayers; i++) {
+		struct Player *player = &game->players[i];
+		player->blocked = false;
+		if (player->status != PLAYER_PLAYING) continue;
+		updatePlayer(player, inputs[i]);
+		checkPlayer(game, player);
+	}
+	PROFILE_END(PROFILE_PLAYERS);
+
+	game->tick++;
+} //end gameStep()
+
+bool gameOver(const struct Game *game) {
+	bool playing = false;
+	for (uint8_t i = 0; i < game->numPlayers; i++) {
+		if (game->players[i].status == PLAYER_WON) return true;
+		if (game->players[i].status == PLAYER_PLAYING) playing = true;
+	}
+	return !playing;
+} //end gameOver()
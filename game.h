@@ -0,0 +1,69 @@
+//**************************************************
+//
+// Authors: Caleb Reiter, Alex Fanner, Chris Chu, Kao Yang
+// Description: Game state and simulation (no input, radio or drawing)
+//
+//**************************************************
+
+#ifndef __GAME_H__
+#define __GAME_H__
+
+#include "ece210_api.h"
+#include "layout.h"
+#include "prng.h"
+#include "entities.h"
+#include "collision.h"
+#include "levelgen.h"
+
+#define GAME_MAX_PLAYERS 8					//most players in a game, at most PROTOCOL_MAX_PLAYERS [players]
+
+#define PLAYER_PLAYING 0						//the player is still on its way across
+#define PLAYER_DEAD 1								//the player was hit by a car or drowned
+#define PLAYER_WON 2								//the player reached the far side
+
+//structure for each player (the logs and cars live in the entity store, see entities.h)
+struct Player {
+		uint8_t xpos;								//x position of player [pixels]
+		uint8_t xfrac;							//sub-pixel part of the x position [1/256 pixels]
+		uint16_t ypos;							//y position of player [pixels]
+		uint8_t move;								//distance the player moves in one hop [pixels]
+		uint8_t direction;					//direction of the player's last move [one of PS2_RIGHT, PS2_UP, PS2_LEFT, PS2_DOWN]
+		uint8_t sprite;							//sprite id of the player's image
+		bool canMove;								//if the player can move (cannot move after moving until its input returns to center)
+		bool blocked;								//if the player tried an invalid move this tick
+		uint8_t status;							//one of PLAYER_PLAYING, PLAYER_DEAD, PLAYER_WON
+};
+
+//everything that decides how a game plays out; two boards holding equal games and stepping
+//them with equal inputs hold equal games afterwards
+struct Game {
+	uint32_t tick;										//ticks simulated since the game started [ticks]
+	struct Prng rng;									//random number generator the lanes and the logs' bounce speeds follow from
+	struct EntityStore entities;			//every log and car
+	struct CollisionLanes lanes;			//the entities sorted for collision checks
+	uint8_t numPlayers;								//number of players in the game
+	struct Player players[GAME_MAX_PLAYERS];	//every player
+};
+
+/* Sets up a new game on a level generated from the seed (see levelgen.h); start positions follow from the seed
+ * Parameters:
+ * 	-*game: the game to set up
+ * 	-seed: the seed every board in the game agreed on
+ * 	-numPlayers: number of players [2, GAME_MAX_PLAYERS]
+ * 	-*level: the level generated from the seed
+ */
+void gameStart(struct Game *game, uint32_t seed, uint8_t numPlayers, const struct Level *level);
+
+/* Simulates one tick: moves the entities, then every player still playing by its input
+ * Parameters:
+ * 	-*game: the game
+ * 	-inputs: each player's input this tick [one of PS2_CENTER, PS2_RIGHT, PS2_UP, PS2_LEFT, PS2_DOWN]
+ */
+void gameStep(struct Game *game, const uint8_t inputs[GAME_MAX_PLAYERS]);
+
+/* Returns true once a player has won or every player has died, which ends the game for everyone
+ * (a player that died keeps watching the others)
+ */
+bool gameOver(const struct Game *game);
+
+#endif
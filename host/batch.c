@@ -0,0 +1,332 @@
+//**************************************************
+//
+// Host-side batch simulator
+// Description: plays out many games headless on every core and reports how
+//              often players die in each lane and how many games run per second
+//
+// Usage: frogger_batch [-g games] [-l levels] [-p players] [-d difficulty] [-t threads] [-s seed]
+//
+// Only the game model is linked (game.c, levelgen.c, entities.c, collision.c, prng.c): no
+// HAL, LCD or radio. gameStep() is the state transition; every player is a bot
+// that hops up as soon as the spot ahead looks safe, backs off when the spot it
+// stands on stops being safe, now and then hops without looking, and now and
+// then steps sideways while it waits.
+//
+// Generating a level costs far more than playing it, so the threads first
+// generate a pool of levels (-l) and every game then draws its level from the
+// pool. Pool level k comes from stream -1 - k of the batch seed, so it never
+// shares a stream with a game.
+//
+// Threads share the games by work stealing: each thread owns a range of game
+// numbers and takes BATCH_CHUNK games at a time from its front; a thread whose
+// range runs dry takes the back half of another thread's range. Game i draws
+// its seed, its level and then its bots' choices from stream i of the batch seed
+// (prngStream), so a batch adds up to the same totals on any number of threads.
+//
+//**************************************************
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "game.h"
+
+#define BATCH_MAX_THREADS 64				//most worker threads [threads]
+#define BATCH_CHUNK 64							//games a thread takes from its own range at once [games]
+#define BATCH_MAX_TICKS 6000				//ticks a game may last before it counts as timed out [ticks]
+#define BATCH_BOLD 256							//one in this many waiting ticks a bot hops up without looking
+#define BATCH_SIDESTEP 64						//one in this many waiting ticks a bot steps sideways
+#define BATCH_MARGIN 3							//room a bot wants between itself and a car [pixels]
+#define BATCH_LEVELS 256						//levels in the pool the games draw from [levels]
+
+/***************************************************
+ * Structures
+ **************************************************/
+
+//games left to one thread, [begin, end) packed into one word so the owner and thieves
+//agree on it with a single compare-and-swap (a cache line each so owners do not collide)
+struct Range {
+	_Atomic uint64_t span;							//begin in the upper half, end in the lower half [games]
+} __attribute__((aligned(64)));
+
+//counters kept by one thread and added up once every thread is done
+struct Totals {
+	uint64_t games;											//games played [games]
+	uint64_t wins;											//games a player won [games]
+	uint64_t wipeouts;									//games every player died in [games]
+	uint64_t timeouts;									//games cut off at BATCH_MAX_TICKS [games]
+	uint64_t ticks;											//ticks simulated [ticks]
+	uint64_t steals;										//ranges taken from another thread
+	uint64_t entered[ENTITY_ROWS];			//times a player hopped into each lane
+	uint64_t deaths[ENTITY_ROWS];				//players that died in each lane
+};
+
+struct Worker {
+	pthread_t thread;
+	uint8_t index;											//the worker's own range
+	struct Totals totals;
+};
+
+/***************************************************
+ * Global Variables
+ **************************************************/
+
+static struct Range ranges[BATCH_MAX_THREADS];		//games left to every thread
+static uint8_t numThreads = 0;										//worker threads
+static uint8_t numPlayers = 2;										//players (bots) in every game
+static uint8_t difficulty = 1;										//difficulty of every game's lanes
+static uint32_t batchSeed = 1;										//seed every game's stream follows from
+static struct Level *levels = NULL;								//the pool every game draws its level from
+static uint32_t numLevels = BATCH_LEVELS;					//levels in the pool
+
+/***************************************************
+ * Helper Functions
+ **************************************************/
+
+#define SPAN(begin, end) (((uint64_t)(begin) << 32) | (uint32_t)(end))
+#define SPAN_BEGIN(span) ((uint32_t)((span) >> 32))
+#define SPAN_END(span) ((uint32_t)(span))
+
+/* Takes the next chunk from the front of a thread's own range */
+static bool takeOwn(struct Range *range, uint32_t *first, uint32_t *last) {
+	uint64_t span = atomic_load(&range->span);
+	uint32_t begin, end;
+
+	do {
+		begin = SPAN_BEGIN(span);
+		end = SPAN_END(span);
+		if (begin >= end) return false;
+		*last = end - begin < BATCH_CHUNK ? end : begin + BATCH_CHUNK;
+	} while (!atomic_compare_exchange_weak(&range->span, &span, SPAN(*last, end)));
+
+	*first = begin;
+	return true;
+}
+
+/* Takes the back half of another thread's range into the thief's own (empty) range */
+static bool steal(uint8_t thief) {
+	for (uint8_t i = 1; i < numThreads; i++) {
+		struct Range *victim = &ranges[(thief + i) % numThreads];
+		uint64_t span = atomic_load(&victim->span);
+		uint32_t begin, end, middle;
+
+		do {
+			begin = SPAN_BEGIN(span);
+			end = SPAN_END(span);
+			if (begin >= end) break;
+			middle = begin + (end - begin) / 2;
+		} while (!atomic_compare_exchange_weak(&victim->span, &span, SPAN(begin, middle)));
+
+		if (begin < end) {
+			atomic_store(&ranges[thief].span, SPAN(middle, end));
+			return true;
+		}
+	}
+	return false;
+}
+
+/* Checks if a player standing in a column of a row would survive the next tick there */
+static bool safe(const struct Game *game, const struct Player *player, uint8_t row) {
+	uint8_t left = player->xpos;
+	uint8_t right = player->xpos + SPRITE_IMAGES[player->sprite].width;
+
+	//the goal row and the start row hold no entities
+	if (row == 0 || row >= GRID_HEIGHT - 1) return true;
+
+	//a log must carry the player; a car must be far enough away not to reach it this tick
+	if (row <= WATER_ROWS) return collisionCover(&game->lanes, &game->entities, row - 1, left, right) != COLLISION_NONE;
+	return collisionOverlap(&game->lanes, &game->entities, row - 1, left - BATCH_MARGIN, right + BATCH_MARGIN) == COLLISION_NONE;
+}
+
+/* Picks a bot's input for the next tick */
+static uint8_t botInput(const struct Game *game, const struct Player *player, struct Prng *rng) {
+	uint8_t row = (player->ypos - TOP_BORDER) / GRID_SIZE;
+
+	//the joystick has to return to center between hops
+	if (player->status != PLAYER_PLAYING || !player->canMove) return PS2_CENTER;
+
+	if (safe(game, player, row - 1) || prngBelow(rng, BATCH_BOLD) == 0) return PS2_UP;
+	if (!safe(game, player, row) && safe(game, player, row + 1)) return PS2_DOWN;
+	if (prngBelow(rng, BATCH_SIDESTEP) == 0) return prngBelow(rng, 2) ? PS2_LEFT : PS2_RIGHT;
+	return PS2_CENTER;
+}
+
+/* Plays one game to its end and adds it to a thread's totals */
+static void playGame(uint32_t index, struct Totals *totals) {
+	struct Game game;
+	struct Prng stream;
+	uint8_t inputs[GAME_MAX_PLAYERS] = {0};
+	uint8_t rows[GAME_MAX_PLAYERS];			//row each player was on after the last tick
+	bool dead[GAME_MAX_PLAYERS] = {0};		//if each player's death was counted
+	bool won = false, alive = false;
+
+	prngStream(&stream, batchSeed, index);
+	uint32_t seed = prngNext(&stream);
+	gameStart(&game, seed, numPlayers, &levels[prngBelow(&stream, numLevels)]);
+	for (uint8_t i = 0; i < numPlayers; i++) rows[i] = (game.players[i].ypos - TOP_BORDER) / GRID_SIZE;
+
+	while (!gameOver(&game) && game.tick < BATCH_MAX_TICKS) {
+		for (uint8_t i = 0; i < numPlayers; i++) inputs[i] = botInput(&game, &game.players[i], &stream);
+		gameStep(&game, inputs);
+
+		for (uint8_t i = 0; i < numPlayers; i++) {
+			const struct Player *player = &game.players[i];
+			uint8_t row = (player->ypos - TOP_BORDER) / GRID_SIZE;
+
+			//a player that is already dead no longer moves, so each lane change and death counts once
+			if (row != rows[i] && row > 0 && row < GRID_HEIGHT - 1) totals->entered[row - 1]++;
+			if (player->status == PLAYER_DEAD && !dead[i]) {
+				if (row > 0 && row < GRID_HEIGHT - 1) totals->deaths[row - 1]++;
+				dead[i] = true;
+			}
+			rows[i] = row;
+		}
+	}
+
+	for (uint8_t i = 0; i < numPlayers; i++) {
+		won |= game.players[i].status == PLAYER_WON;
+		alive |= game.players[i].status != PLAYER_DEAD;
+	}
+	totals->games++;
+	totals->ticks += game.tick;
+	if (won) totals->wins++;
+	else if (!alive) totals->wipeouts++;
+	else totals->timeouts++;
+}
+
+/* Generates every numThreads-th level of the pool, starting at the worker's own index */
+static void *generate(void *arg) {
+	struct Worker *worker = arg;
+
+	for (uint32_t k = worker->index; k < numLevels; k += numThreads) {
+		struct Prng stream;
+		prngStream(&stream, batchSeed, UINT32_MAX - k);
+		levelGenerate(&levels[k], prngNext(&stream), difficulty);
+	}
+	return NULL;
+}
+
+static void *work(void *arg) {
+	struct Worker *worker = arg;
+	uint32_t first, last;
+
+	for (;;) {
+		while (takeOwn(&ranges[worker->index], &first, &last)) {
+			for (uint32_t game = first; game < last; game++) playGame(game, &worker->totals);
+		}
+		if (!steal(worker->index)) break;
+		worker->totals.steals++;
+	}
+	return NULL;
+}
+
+/* Parses a count given on the command line
+ * Parameters:
+ * 	-text: the option's argument
+ * Returns:
+ * 	-the number, or -1 if the text is not all a decimal number (so it fails any range check)
+ */
+static long parseCount(const char *text) {
+	char *end;
+	long value = strtol(text, &end, 10);
+	return end == text || *end != '\0' ? -1 : value;
+} //end parseCount()
+
+/***************************************************
+ * Functions
+ **************************************************/
+
+int main(int argc, char **argv) {
+	static struct Worker workers[BATCH_MAX_THREADS];
+	struct Totals sum = {0};
+	struct timespec start, stop;
+	uint32_t games = 100000;
+	long cores = sysconf(_SC_NPROCESSORS_ONLN);
+	long players = numPlayers, level = difficulty, threads;		//parsed wide so they are checked before narrowing
+	int opt;
+
+	threads = cores < 1 ? 1 : cores > BATCH_MAX_THREADS ? BATCH_MAX_THREADS : cores;
+	while ((opt = getopt(argc, argv, "g:l:p:d:t:s:")) != -1) {
+		switch (opt) {
+			case 'g': games = strtoul(optarg, NULL, 0); break;
+			case 'l': numLevels = strtoul(optarg, NULL, 0); break;
+			case 'p': players = parseCount(optarg); break;
+			case 'd': level = parseCount(optarg); break;
+			case 't': threads = parseCount(optarg); break;
+			case 's': batchSeed = strtoul(optarg, NULL, 0); break;
+			default:
+				fprintf(stderr, "usage: %s [-g games] [-l levels] [-p players] [-d difficulty] [-t threads] [-s seed]\n", argv[0]);
+				return 1;
+		}
+	}
+	if (players < 2 || players > GAME_MAX_PLAYERS || level < 0 || level >= LEVEL_DIFFICULTIES || threads < 1
+			|| threads > BATCH_MAX_THREADS || games == 0 || numLevels == 0) {
+		fprintf(stderr, "batch: players must be 2-%d, difficulty 0-%d, threads 1-%d and games and levels at least 1\n",
+						GAME_MAX_PLAYERS, LEVEL_DIFFICULTIES - 1, BATCH_MAX_THREADS);
+		return 1;
+	}
+	numPlayers = players;
+	difficulty = level;
+	numThreads = threads;
+	levels = malloc(numLevels * sizeof(struct Level));
+	if (levels == NULL) {
+		perror("batch");
+		return 1;
+	}
+
+	//generate the pool of levels on every thread
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (uint8_t i = 0; i < numThreads; i++) {
+		workers[i].index = i;
+		pthread_create(&workers[i].thread, NULL, generate, &workers[i]);
+	}
+	for (uint8_t i = 0; i < numThreads; i++) pthread_join(workers[i].thread, NULL);
+	clock_gettime(CLOCK_MONOTONIC, &stop);
+	printf("batch: %u levels at difficulty %u generated in %.2f s\n", numLevels, difficulty,
+				 (stop.tv_sec - start.tv_sec) + (stop.tv_nsec - start.tv_nsec) / 1e9);
+
+	//deal the games out evenly; stealing evens out whatever the split gets wrong
+	for (uint8_t i = 0; i < numThreads; i++) {
+		atomic_init(&ranges[i].span, SPAN((uint64_t)games * i / numThreads, (uint64_t)games * (i + 1) / numThreads));
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (uint8_t i = 0; i < numThreads; i++) {
+		pthread_create(&workers[i].thread, NULL, work, &workers[i]);
+	}
+	for (uint8_t i = 0; i < numThreads; i++) {
+		pthread_join(workers[i].thread, NULL);
+
+		const struct Totals *totals = &workers[i].totals;
+		sum.games += totals->games;
+		sum.wins += totals->wins;
+		sum.wipeouts += totals->wipeouts;
+		sum.timeouts += totals->timeouts;
+		sum.ticks += totals->ticks;
+		sum.steals += totals->steals;
+		for (uint8_t lane = 0; lane < ENTITY_ROWS; lane++) {
+			sum.entered[lane] += totals->entered[lane];
+			sum.deaths[lane] += totals->deaths[lane];
+		}
+	}
+	clock_gettime(CLOCK_MONOTONIC, &stop);
+
+	double seconds = (stop.tv_sec - start.tv_sec) + (stop.tv_nsec - start.tv_nsec) / 1e9;
+	printf("batch: %llu games of %u players at difficulty %u on %u threads in %.2f s: %.0f games/s, %.2f M ticks/s, %llu steals\n",
+				 (unsigned long long)sum.games, numPlayers, difficulty, numThreads, seconds, sum.games / seconds,
+				 sum.ticks / seconds / 1e6, (unsigned long long)sum.steals);
+	printf("batch: won %.1f%%, every player dead %.1f%%, timed out %.1f%%, %.0f ticks per game\n",
+				 100.0 * sum.wins / sum.games, 100.0 * sum.wipeouts / sum.games, 100.0 * sum.timeouts / sum.games,
+				 (double)sum.ticks / sum.games);
+	printf("batch: lane  kind     entered    deaths  deaths/entered\n");
+	for (uint8_t lane = 0; lane < ENTITY_ROWS; lane++) {
+		printf("batch: %4u  %-5s %10llu %9llu  %13.2f%%\n", lane, lane < WATER_ROWS ? "water" : "road",
+					 (unsigned long long)sum.entered[lane], (unsigned long long)sum.deaths[lane],
+					 sum.entered[lane] ? 100.0 * sum.deaths[lane] / sum.entered[lane] : 0.0);
+	}
+	free(levels);
+	return 0;
+}
@@ -0,0 +1,554 @@
+//**************************************************
+//
+// Host-side simulator for the ECE210 board API
+// Description: implements ece210_api.h on Linux with an in-memory RGB565
+//              framebuffer, scripted buttons/joystick, a radio channel shared
+//              with the other simulated boards, and a virtual clock that
+//              charges every call the bus time it would cost on the board
+//
+// Boards exchange packets through shared memory stamped with virtual time.
+// A board reading its radio first waits until no other board can still send
+// a packet that would arrive by its own virtual time, so a session plays out
+// identically on every run no matter how the host schedules the processes.
+//
+//**************************************************
+
+#include <sched.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <time.h>
+
+#include "ece210_api.h"
+#include "ece210_sim.h"
+
+#define SIM_RING_SIZE 64						//packets queued between two boards [packets]
+
+/***************************************************
+ * Structures
+ **************************************************/
+
+//one line of an input script: state of the inputs from a given time onwards
+struct SimInput {
+	uint32_t timeMs;							//time the state takes effect [ms]
+	uint8_t buttons;							//button mask as returned by ece210_buttons_read()
+	uint8_t joystick;							//joystick position (one of PS2_CENTER, PS2_UP, ...)
+};
+
+//packet travelling between two boards
+struct SimPacket {
+	uint64_t arriveUs;						//virtual time the packet reaches the receiver [us]
+	uint8_t src;									//local ID of the sender
+	uint8_t dst;									//remote ID the sender addressed
+	uint32_t data;								//payload
+};
+
+//single-producer single-consumer queue of packets from one board to another
+struct SimRing {
+	uint32_t head;								//next packet to be read
+	uint32_t tail;								//next free entry
+	struct SimPacket packets[SIM_RING_SIZE];	//queued packets
+};
+
+//radio channel shared by every board (lives in memory shared across the board processes)
+struct SimEther {
+	uint8_t boards;																			//number of boards in the session
+	uint64_t timeUs[SIM_MAX_BOARDS];										//virtual time of each board [us]
+	struct SimRing rings[SIM_MAX_BOARDS][SIM_MAX_BOARDS];	//packets queued from [sender][receiver]
+};
+
+/***************************************************
+ * Global Variables
+ **************************************************/
+
+#define SIM_MAX_INPUTS 1024					//maximum number of lines in an input script [lines]
+#define SIM_TIME_DONE (UINT64_MAX / 2)	//virtual time published by a board that has exited [us]
+
+volatile bool AlertTouch = false;
+volatile bool AlertButtons = false;
+volatile bool ALERT_ADC = false;
+volatile bool ALERT_AUDIO_COMP = false;
+
+static uint16_t framebuffer[SIM_LCD_WIDTH * SIM_LCD_HEIGHT];
+static struct SimStats stats;
+static struct SimInput inputs[SIM_MAX_INPUTS];
+static uint16_t numInputs = 0;
+static uint32_t scriptEndMs = 0;
+static uint8_t lastButtons = 0;
+
+static uint8_t boardIndex = 0;
+static struct SimEther *ether = NULL;
+static uint8_t localId = 0, remoteId = 0;
+static uint32_t rxFifo[SIM_RADIO_FIFO_DEPTH];
+static uint8_t rxCount = 0;
+
+static const char *dumpPrefix = NULL;
+static uint64_t frameStartUs = 0, frameStartBytes = 0;
+static uint64_t frameIdleUs = 0;						//virtual time spent idle since the last frame ended [us]
+static struct timespec wallStart;
+static struct timespec rollbackStart;
+
+/***************************************************
+ * Simulator Control
+ **************************************************/
+
+static void simReport(void);
+
+static void simLoadScript(const char *path, uint32_t delayMs) {
+	FILE *file = fopen(path, "r");
+	char line[128];
+
+	if (file == NULL) {
+		fprintf(stderr, "sim: cannot open script %s\n", path);
+		exit(1);
+	}
+
+	//each line is "<time ms> <buttons UDLR or -> <joystick CUDLR>" or "<time ms> end"
+	while (fgets(line, sizeof(line), file) != NULL && numInputs < SIM_MAX_INPUTS) {
+		uint32_t timeMs;
+		char buttons[8], joystick[8];
+		if (line[0] == '#' || line[0] == '\n') continue;
+		if (sscanf(line, "%u %7s %7s", &timeMs, buttons, joystick) < 2) continue;
+		if (strcmp(buttons, "end") == 0) {
+			scriptEndMs = timeMs;
+			break;
+		}
+
+		struct SimInput *input = &inputs[numInputs++];
+		input->timeMs = timeMs + delayMs;
+		input->buttons = 0;
+		for (char *c = buttons; *c; c++) {
+			if (*c == 'U') input->buttons |= 0x01;
+			if (*c == 'D') input->buttons |= 0x02;
+			if (*c == 'L') input->buttons |= 0x04;
+			if (*c == 'R') input->buttons |= 0x08;
+		}
+		switch (joystick[0]) {
+			case 'U': input->joystick = PS2_UP; break;
+			case 'D': input->joystick = PS2_DOWN; break;
+			case 'L': input->joystick = PS2_LEFT; break;
+			case 'R': input->joystick = PS2_RIGHT; break;
+			default: input->joystick = PS2_CENTER; break;
+		}
+		scriptEndMs = input->timeMs;
+	}
+	fclose(file);
+}
+
+void simEtherCreate(uint8_t boards) {
+	ether = mmap(NULL, sizeof(struct SimEther), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+	if (ether == MAP_FAILED) {
+		perror("sim: mmap");
+		exit(1);
+	}
+	memset(ether, 0, sizeof(struct SimEther));
+	ether->boards = boards;
+}
+
+void simEtherRelease(uint8_t board) {
+	if (ether != NULL) __atomic_store_n(&ether->timeUs[board], SIM_TIME_DONE, __ATOMIC_RELEASE);
+}
+
+static void simExit(void) {
+	simEtherRelease(boardIndex);
+}
+
+void simInit(uint8_t board, const char *script, uint32_t delayMs, const char *prefix) {
+	boardIndex = board;
+	dumpPrefix = prefix;
+	simLoadScript(script, delayMs);
+	atexit(simExit);
+	clock_gettime(CLOCK_MONOTONIC, &wallStart);
+}
+
+static const struct SimInput *simCurrentInput(void) {
+	static const struct SimInput idle = {0, 0, PS2_CENTER};
+	const struct SimInput *current = &idle;
+	uint32_t nowMs = stats.timeUs / 1000;
+	for (uint16_t i = 0; i < numInputs && inputs[i].timeMs <= nowMs; i++) {
+		current = &inputs[i];
+	}
+	return current;
+}
+
+static void simCheckButtons(void) {
+	//the IO expander raises the GPIOF interrupt whenever the button state changes
+	uint8_t buttons = simCurrentInput()->buttons;
+	if (buttons != lastButtons) {
+		lastButtons = buttons;
+		AlertButtons = true;
+	}
+}
+
+void simAdvanceUs(uint64_t us) {
+	stats.timeUs += us;
+	if (ether != NULL) __atomic_store_n(&ether->timeUs[boardIndex], stats.timeUs, __ATOMIC_RELEASE);
+	simCheckButtons();
+	if (stats.timeUs / 1000 >= scriptEndMs) {
+		simReport();
+		exit(0);
+	}
+}
+
+void simIdleUs(uint64_t us) {
+	frameIdleUs += us;
+	simAdvanceUs(us);
+}
+
+static void simLcdTransfer(uint32_t pixels) {
+	uint64_t bytes = SIM_LCD_WINDOW_BYTES + (uint64_t)pixels * 2;
+	stats.lcdCalls++;
+	stats.lcdBytes += bytes;
+	simAdvanceUs((bytes * SIM_LCD_BYTE_NS + 999) / 1000);
+}
+
+static void simWritePixel(int32_t x, int32_t y, uint16_t color) {
+	if (x < 0 || y < 0 || x >= SIM_LCD_WIDTH || y >= SIM_LCD_HEIGHT) return;
+	framebuffer[y * SIM_LCD_WIDTH + x] = color;
+}
+
+void simFrameEnd(void) {
+	if (frameStartUs != 0) {
+		stats.frames++;
+		stats.frameTimeUs += stats.timeUs - frameStartUs;
+		stats.frameLcdBytes += stats.lcdBytes - frameStartBytes;
+		stats.idleUs += frameIdleUs;
+	}
+	frameStartUs = stats.timeUs;
+	frameStartBytes = stats.lcdBytes;
+	frameIdleUs = 0;
+}
+
+void simFrameStop(void) {
+	frameStartUs = 0;
+	frameIdleUs = 0;
+}
+
+void simRollbackBegin(void) {
+	clock_gettime(CLOCK_MONOTONIC, &rollbackStart);
+}
+
+void simRollbackEnd(uint32_t ticks) {
+	struct timespec end;
+	if (ticks == 0) return;
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	stats.rollbacks++;
+	stats.rollbackTicks += ticks;
+	if (ticks > stats.rollbackMaxTicks) stats.rollbackMaxTicks = ticks;
+	stats.rollbackNs += (end.tv_sec - rollbackStart.tv_sec) * 1000000000ull + end.tv_nsec - rollbackStart.tv_nsec;
+}
+
+uint8_t simBoard(void) {
+	return boardIndex;
+}
+
+uint64_t simTimeUs(void) {
+	return stats.timeUs;
+}
+
+uint16_t *simFramebuffer(void) {
+	return framebuffer;
+}
+
+const struct SimStats *simStats(void) {
+	return &stats;
+}
+
+static void simDump(void) {
+	char path[256];
+	FILE *file;
+
+	snprintf(path, sizeof(path), "%s%u.ppm", dumpPrefix, boardIndex);
+	file = fopen(path, "wb");
+	if (file == NULL) return;
+	fprintf(file, "P6\n%d %d\n255\n", SIM_LCD_WIDTH, SIM_LCD_HEIGHT);
+	for (uint32_t i = 0; i < SIM_LCD_WIDTH * SIM_LCD_HEIGHT; i++) {
+		uint16_t c = framebuffer[i];
+		uint8_t rgb[3] = {(c >> 11) << 3, ((c >> 5) & 0x3F) << 2, (c & 0x1F) << 3};
+		fwrite(rgb, 1, 3, file);
+	}
+	fclose(file);
+}
+
+static void simReport(void) {
+	struct timespec wallEnd;
+	clock_gettime(CLOCK_MONOTONIC, &wallEnd);
+	double wallNs = (wallEnd.tv_sec - wallStart.tv_sec) * 1e9 + (wallEnd.tv_nsec - wallStart.tv_nsec);
+	uint32_t frames = stats.frames ? stats.frames : 1;
+
+	printf("board %u: %.3f s simulated, %u frames, %.1f us/frame (%.1f fps), %.0f LCD bytes/frame, %.1f us/frame slack\n"
+				 "board %u: LCD %llu bytes in %u calls, I2C %u reads, ADC %u reads, LED %u writes\n"
+				 "board %u: radio %u sent, %u received, %u dropped, %u not delivered, host %.0f ns/frame\n"
+				 "board %u: rollback %u times, %u ticks simulated again (at most %u at once), host %.0f ns/tick simulated again\n",
+				 boardIndex, stats.timeUs / 1e6, stats.frames, (double)stats.frameTimeUs / frames,
+				 stats.frameTimeUs ? 1e6 * stats.frames / stats.frameTimeUs : 0.0,
+				 (double)stats.frameLcdBytes / frames, (double)stats.idleUs / frames,
+				 boardIndex, (unsigned long long)stats.lcdBytes, stats.lcdCalls, stats.i2cReads, stats.adcReads, stats.ledWrites,
+				 boardIndex, stats.radioSent, stats.radioReceived, stats.radioDropped, stats.radioSendDropped, wallNs / frames,
+				 boardIndex, stats.rollbacks, stats.rollbackTicks, stats.rollbackMaxTicks,
+				 stats.rollbackTicks ? (double)stats.rollbackNs / stats.rollbackTicks : 0.0);
+	fflush(stdout);
+	if (dumpPrefix != NULL) simDump();
+}
+
+/***************************************************
+ * Board
+ **************************************************/
+
+void ece210_initialize_board(void) {
+	memset(framebuffer, 0, sizeof(framebuffer));
+}
+
+void DisableInterrupts(void) {}
+
+void EnableInterrupts(void) {}
+
+void GPIOF_Handler(void) {}
+
+void ece210_wait_mSec(uint32_t mSeconds) {
+	simAdvanceUs((uint64_t)mSeconds * 1000);
+}
+
+/***************************************************
+ * Inputs
+ **************************************************/
+
+uint8_t ece210_buttons_read(void) {
+	stats.i2cReads++;
+	simAdvanceUs(SIM_I2C_READ_US);
+	return simCurrentInput()->buttons;
+}
+
+uint8_t ece210_switches_read(void) {
+	stats.i2cReads++;
+	simAdvanceUs(SIM_I2C_READ_US);
+	return 0;
+}
+
+uint8_t ece210_ps2_read_position(void) {
+	stats.adcReads++;
+	simAdvanceUs(SIM_ADC_READ_US);
+	return simCurrentInput()->joystick;
+}
+
+//a resting joystick reads mid-scale give or take a few counts of noise that differs from board to board
+static uint16_t simAdcCenter(void) {
+	static uint32_t noise = 0;
+	if (noise == 0) noise = 0x9E3779B9u * (boardIndex + 1);
+	noise ^= noise << 13;
+	noise ^= noise >> 17;
+	noise ^= noise << 5;
+	return 0x800 - SIM_ADC_NOISE + noise % (2 * SIM_ADC_NOISE + 1);
+}
+
+uint16_t ece210_ps2_read_x(void) {
+	uint8_t position = ece210_ps2_read_position();
+	return position == PS2_LEFT ? 0xFFF : position == PS2_RIGHT ? 0 : simAdcCenter();
+}
+
+uint16_t ece210_ps2_read_y(void) {
+	uint8_t position = ece210_ps2_read_position();
+	return position == PS2_UP ? 0xFFF : position == PS2_DOWN ? 0 : simAdcCenter();
+}
+
+/***************************************************
+ * LEDs
+ **************************************************/
+
+void ece210_red_leds_write(uint8_t leds) {
+	simAdvanceUs(SIM_I2C_READ_US);
+}
+
+void ece210_tiva_rgb_write(uint8_t leds) {}
+
+void ece210_ws2812b_write(uint8_t led_num, uint8_t red, uint8_t green, uint8_t blue) {
+	stats.ledWrites++;
+	simAdvanceUs(SIM_WS2812B_WRITE_US);
+}
+
+void simLedsWrite(const uint8_t *grb, uint8_t leds) {
+	stats.ledWrites++;
+	simAdvanceUs(SIM_WS2812B_WRITE_US);
+}
+
+void simReplayWrite(const uint8_t *bytes, uint16_t count) {
+	static FILE *file = NULL;
+	char path[256];
+
+	if (dumpPrefix == NULL) return;
+	if (file == NULL) {
+		snprintf(path, sizeof(path), "%s%u.rec", dumpPrefix, boardIndex);
+		file = fopen(path, "wb");
+		if (file == NULL) return;
+	}
+	//flushed by exit() with every other stream
+	fwrite(bytes, 1, count, file);
+}
+
+/***************************************************
+ * LCD
+ **************************************************/
+
+void ece210_lcd_add_msg(char *msg, uint8_t alignment, uint32_t color) {
+	//the terminal scrolls by redrawing every line of the screen
+	if (getenv("SIM_VERBOSE") != NULL && msg[0] != '\0') printf("board %u: %s\n", boardIndex, msg);
+	simLcdTransfer(SIM_LCD_WIDTH * SIM_LCD_HEIGHT);
+}
+
+void ece210_lcd_print_string(char *string, uint16_t x_pos, uint16_t y_pos, uint16_t fg_color, uint16_t bg_color) {
+	simLcdTransfer(strlen(string) * 8 * 16);
+}
+
+void ece210_draw_pixel(uint16_t x, uint16_t y, uint16_t color) {
+	ece210_lcd_draw_pixel(x, y, color);
+}
+
+void ece210_lcd_draw_pixel(uint16_t x, uint16_t y, uint16_t color) {
+	simWritePixel(x, y, color);
+	simLcdTransfer(1);
+}
+
+void ece210_lcd_draw_rectangle(uint16_t x_start, uint16_t x_len, uint16_t y_start, uint16_t y_len, uint16_t color) {
+	//the panel clips the window to the screen
+	int32_t x_end = (int32_t)x_start + x_len > SIM_LCD_WIDTH ? SIM_LCD_WIDTH : x_start + x_len;
+	int32_t y_end = (int32_t)y_start + y_len > SIM_LCD_HEIGHT ? SIM_LCD_HEIGHT : y_start + y_len;
+	uint32_t pixels = 0;
+
+	for (int32_t y = y_start; y < y_end; y++) {
+		for (int32_t x = x_start; x < x_end; x++) {
+			simWritePixel(x, y, color);
+			pixels++;
+		}
+	}
+	simLcdTransfer(pixels);
+}
+
+void ece210_lcd_draw_image(uint16_t x_start, uint16_t image_width_bits, uint16_t y_start, uint16_t image_height_pixels,
+													 const uint8_t *image, uint16_t fColor, uint16_t bColor) {
+	uint16_t bytesPerRow = (image_width_bits + 7) / 8;
+
+	for (uint16_t y = 0; y < image_height_pixels; y++) {
+		for (uint16_t x = 0; x < image_width_bits; x++) {
+			bool set = image[y * bytesPerRow + x / 8] & (0x80 >> (x % 8));
+			simWritePixel(x_start + x, y_start + y, set ? fColor : bColor);
+		}
+	}
+	simLcdTransfer((uint32_t)image_width_bits * image_height_pixels);
+}
+
+void ece210_lcd_draw_line(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, uint16_t color) {
+	int32_t dx = abs((int32_t)x1 - x0), dy = -abs((int32_t)y1 - y0);
+	int32_t sx = x0 < x1 ? 1 : -1, sy = y0 < y1 ? 1 : -1;
+	int32_t err = dx + dy, x = x0, y = y0;
+
+	while (true) {
+		ece210_lcd_draw_pixel(x, y, color);
+		if (x == x1 && y == y1) break;
+		if (2 * err >= dy) { err += dy; x += sx; }
+		if (2 * err <= dx) { err += dx; y += sy; }
+	}
+}
+
+void ece210_lcd_draw_circle(int16_t x0, int16_t y0, int16_t radius, uint32_t color) {
+	for (int16_t y = -radius; y <= radius; y++) {
+		for (int16_t x = -radius; x <= radius; x++) {
+			if (x * x + y * y <= radius * radius) simWritePixel(x0 + x, y0 + y, color);
+		}
+	}
+	simLcdTransfer((2 * radius + 1) * (2 * radius + 1));
+}
+
+/***************************************************
+ * Audio (unused by the game)
+ **************************************************/
+
+bool ece210_audio_init(uint32_t micro_seconds) { return true; }
+uint16_t ece210_audio_read(void) { return 0x800; }
+void ece210_audio_set_comparator_threshold(uint8_t threshold) {}
+void ece210_audio_headphone_out(uint8_t data) {}
+bool ece210_audio_comparator_above_threshold(void) { return false; }
+
+/***************************************************
+ * Wireless
+ **************************************************/
+
+static void simRadioPoll(void) {
+	if (ether == NULL) return;
+
+	//wait until every other board is far enough along that it cannot still send a packet arriving by now
+	for (uint8_t board = 0; board < ether->boards; board++) {
+		if (board == boardIndex) continue;
+		while (__atomic_load_n(&ether->timeUs[board], __ATOMIC_ACQUIRE) + SIM_RADIO_SEND_US <= stats.timeUs) {
+			sched_yield();
+		}
+	}
+
+	//move every packet that has arrived into the receive FIFO in arrival order; packets arriving while it is full are lost
+	while (true) {
+		struct SimRing *first = NULL;
+		for (uint8_t board = 0; board < ether->boards; board++) {
+			struct SimRing *ring = &ether->rings[board][boardIndex];
+			uint32_t head = ring->head;
+			if (head == __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE)) continue;
+			if (ring->packets[head % SIM_RING_SIZE].arriveUs > stats.timeUs) continue;
+			if (first == NULL || ring->packets[head % SIM_RING_SIZE].arriveUs < first->packets[first->head % SIM_RING_SIZE].arriveUs) {
+				first = ring;
+			}
+		}
+		if (first == NULL) break;
+
+		if (rxCount < SIM_RADIO_FIFO_DEPTH) {
+			rxFifo[rxCount++] = first->packets[first->head % SIM_RING_SIZE].data;
+		} else {
+			stats.radioDropped++;
+		}
+		__atomic_store_n(&first->head, first->head + 1, __ATOMIC_RELEASE);
+	}
+}
+
+void ece210_wireless_init(uint8_t local_id, uint8_t remote_id) {
+	localId = local_id;
+	remoteId = remote_id;
+	rxCount = 0;
+	simAdvanceUs(SIM_RADIO_SPI_US * 8);
+}
+
+bool ece210_wireless_send(uint32_t data) {
+	struct SimPacket packet = {stats.timeUs + SIM_RADIO_SEND_US, localId, remoteId, data};
+	bool delivered = false;
+
+	stats.radioSent++;
+	if (ether != NULL) {
+		//every other board hears the transmission
+		for (uint8_t board = 0; board < ether->boards; board++) {
+			struct SimRing *ring = &ether->rings[boardIndex][board];
+			if (board == boardIndex) continue;
+			if (ring->tail - __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE) >= SIM_RING_SIZE) {
+				stats.radioSendDropped++;
+				continue;
+			}
+			ring->packets[ring->tail % SIM_RING_SIZE] = packet;
+			__atomic_store_n(&ring->tail, ring->tail + 1, __ATOMIC_RELEASE);
+			delivered = true;
+		}
+	}
+	simAdvanceUs(SIM_RADIO_SEND_US);
+	return delivered;
+}
+
+bool ece210_wireless_data_avaiable(void) {
+	simAdvanceUs(SIM_RADIO_SPI_US);
+	simRadioPoll();
+	return rxCount > 0;
+}
+
+uint32_t ece210_wireless_get(void) {
+	uint32_t data;
+
+	simAdvanceUs(SIM_RADIO_SPI_US);
+	simRadioPoll();
+	if (rxCount == 0) return 0;
+	data = rxFifo[0];
+	memmove(rxFifo, rxFifo + 1, --rxCount * sizeof(rxFifo[0]));
+	stats.radioReceived++;
+	return data;
+}
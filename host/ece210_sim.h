@@ -0,0 +1,127 @@
+//**************************************************
+//
+// Host-side simulator for the ECE210 board API
+// Description: controls and counters for the simulated HAL that lets the
+//              game build and run on a plain Linux box (see host/Makefile)
+//
+//**************************************************
+
+#ifndef __ECE210_SIM_H__
+#define __ECE210_SIM_H__
+
+#include <stdint.h>
+
+#define SIM_LCD_WIDTH 240						//simulated LCD width [pixels]
+#define SIM_LCD_HEIGHT 320					//simulated LCD height [pixels]
+#define SIM_MAX_BOARDS 8						//maximum number of simulated boards [boards]
+#define SIM_STAGGER_MS 70					//delay added to a script each time another board reuses it [ms]
+
+#define SIM_LCD_BYTE_NS 400					//time to clock one byte to the LCD (20 MHz SPI equivalent) [ns]
+#define SIM_LCD_WINDOW_BYTES 11			//bytes needed to open a drawing window (CASET + PASET + RAMWR) [bytes]
+#define SIM_I2C_READ_US 360					//IO expander register read over 100 kHz I2C [us]
+#define SIM_ADC_READ_US 4						//one joystick ADC conversion pair [us]
+#define SIM_ADC_NOISE 6							//noise on a resting joystick reading [counts]
+#define SIM_RADIO_SPI_US 10					//one radio FIFO/status access over SPI [us]
+#define SIM_RADIO_SEND_US 300				//radio transmit including airtime and auto-ack [us]
+#define SIM_RADIO_FIFO_DEPTH 3			//depth of the radio's receive FIFO [packets]
+#define SIM_WS2812B_WRITE_US 290		//re-sending the 8 LED chain plus latch [us]
+
+//counters kept by the simulated HAL for one board
+struct SimStats {
+	uint64_t timeUs;							//virtual time since reset [us]
+	uint32_t frames;							//completed game loop passes [frames]
+	uint64_t frameTimeUs;					//virtual time spent inside counted frames [us]
+	uint64_t idleUs;							//virtual time spent idle inside counted frames [us]
+	uint64_t lcdBytes;						//bytes sent to the LCD [bytes]
+	uint32_t lcdCalls;						//LCD drawing calls [calls]
+	uint64_t frameLcdBytes;				//LCD bytes sent inside counted frames [bytes]
+	uint32_t i2cReads;						//IO expander reads [reads]
+	uint32_t adcReads;						//joystick reads [reads]
+	uint32_t radioSent;						//packets transmitted [packets]
+	uint32_t radioReceived;				//packets read by the game [packets]
+	uint32_t radioDropped;				//packets lost to a full receive FIFO [packets]
+	uint32_t radioSendDropped;		//copies of sent packets lost to another board's full ring (it fell far behind) [packets]
+	uint32_t ledWrites;						//WS2812B chain writes [writes]
+	uint32_t rollbacks;						//times the game went back to correct a guessed input [rollbacks]
+	uint32_t rollbackTicks;				//ticks simulated again [ticks]
+	uint32_t rollbackMaxTicks;		//most ticks simulated again at once [ticks]
+	uint64_t rollbackNs;					//host time spent going back and simulating again [ns]
+};
+
+/* Creates the radio channel shared by every simulated board; call once before the boards are started
+ * Parameters:
+ * 	-boards: number of boards in the simulated session
+ */
+void simEtherCreate(uint8_t boards);
+
+/* Releases a board's hold on the shared radio channel (used by the launcher when a board dies)
+ * Parameters:
+ * 	-board: index of the board
+ */
+void simEtherRelease(uint8_t board);
+
+/* Prepares the simulated board before the game's main() is entered
+ * Parameters:
+ * 	-board: index of this board in the simulated session
+ * 	-script: path of the scripted input file for this board
+ * 	-delayMs: delay added to every input of the script (not to its end) [ms]
+ * 	-dumpPrefix: prefix of the framebuffer dump written at exit (NULL for none)
+ */
+void simInit(uint8_t board, const char *script, uint32_t delayMs, const char *dumpPrefix);
+
+/* Marks the end of one pass of the game loop so per-frame costs can be reported */
+void simFrameEnd(void);
+
+/* Marks the end of the game loop, so the time until the next game's first frame (the lobby, the countdown)
+ * is not counted as a frame or as its slack
+ */
+void simFrameStop(void);
+
+/* Starts timing a rollback on the host clock (the virtual clock does not charge game logic) */
+void simRollbackBegin(void);
+
+/* Stops timing a rollback and counts it if any ticks were simulated again
+ * Parameters:
+ * 	-ticks: number of ticks simulated again [ticks]
+ */
+void simRollbackEnd(uint32_t ticks);
+
+/* Returns the index of this board in the simulated session */
+uint8_t simBoard(void);
+
+/* Returns the virtual time since reset [microseconds] */
+uint64_t simTimeUs(void);
+
+/* Advances the virtual clock
+ * Parameters:
+ * 	-us: time to add [microseconds]
+ */
+void simAdvanceUs(uint64_t us);
+
+/* Advances the virtual clock while the game has nothing to do (reported as slack if inside a counted frame)
+ * Parameters:
+ * 	-us: time to add [microseconds]
+ */
+void simIdleUs(uint64_t us);
+
+/* Sends a whole frame down the WS2812B chain in one transfer (the board library's WS2812B_write())
+ * Parameters:
+ * 	-*grb: green, red and blue level of every LED in chain order
+ * 	-leds: number of LEDs [LEDs]
+ */
+void simLedsWrite(const uint8_t *grb, uint8_t leds);
+
+/* Appends bytes of the board's game recording to <dump prefix><board>.rec (nothing without a dump prefix)
+ * Parameters:
+ * 	-*bytes: the bytes
+ * 	-count: number of bytes [bytes]
+ */
+void simReplayWrite(const uint8_t *bytes, uint16_t count);
+
+/* Returns the simulated 240x320 RGB565 framebuffer (row-major) */
+uint16_t *simFramebuffer(void);
+
+/* Returns the counters for this board */
+const struct SimStats *simStats(void);
+
+#endif
@@ -0,0 +1,107 @@
+//**************************************************
+//
+// Host-side level pack generator
+// Description: generates levels the way the game does at the start of every
+//              game and writes them out as a C table, reporting how long the
+//              solvability search takes and how hard the levels came out
+//
+// Usage: frogger_levels [-n levels] [-d difficulty] [-s seed] levels.c
+//
+// Level i is the level a game started with seed i of the pack's stream
+// (prngStream) plays, so an entry's seed reproduces it on the board. Only the
+// game model is linked; the times are the host's, the board's search takes
+// longer by about the ratio of the clocks. The tool also searches
+// LEVEL_FALLBACK again and fails if it is not crossed as recorded.
+//
+//**************************************************
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "levelgen.h"
+
+/* Writes one level as an initializer of struct Level */
+static void writeLevel(FILE *out, const struct Level *level, uint32_t seed, uint8_t drawn) {
+	fprintf(out, "\t//seed 0x%08x, %u layouts drawn\n", seed, drawn);
+	fprintf(out, "\t{%u, %u, {0x%08x, %u}, {\n", level->difficulty, level->crossing, level->rng.key, level->rng.counter);
+	for (uint8_t lane = 0; lane < ENTITY_ROWS; lane++) {
+		const struct LanePattern *pattern = &level->lanes[lane];
+
+		fprintf(out, "\t\t{%u, %s, 0x%04x, {", pattern->count, pattern->direction == PS2_RIGHT ? "PS2_RIGHT" : "PS2_LEFT", pattern->speed);
+		for (uint8_t j = 0; j < MAX_ENTITIES_PER_ROW; j++) fprintf(out, "%s%u", j ? ", " : "", pattern->sprite[j]);
+		fprintf(out, "}, {");
+		for (uint8_t j = 0; j < MAX_ENTITIES_PER_ROW; j++) fprintf(out, "%s%u", j ? ", " : "", pattern->xpos[j]);
+		fprintf(out, "}}%s\n", lane < ENTITY_ROWS - 1 ? "," : "");
+	}
+	fprintf(out, "\t}}");
+}
+
+int main(int argc, char **argv) {
+	struct timespec start, stop;
+	uint32_t levels = 64, packSeed = 1;
+	uint8_t difficulty = LEVEL_DIFFICULTIES - 1;
+	uint64_t drawnTotal = 0, crossingTotal = 0, eased = 0, fallbacks = 0;
+	double slowest = 0, total = 0;
+	int opt;
+
+	while ((opt = getopt(argc, argv, "n:d:s:")) != -1) {
+		switch (opt) {
+			case 'n': levels = strtoul(optarg, NULL, 0); break;
+			case 'd': difficulty = atoi(optarg); break;
+			case 's': packSeed = strtoul(optarg, NULL, 0); break;
+			default:
+				fprintf(stderr, "usage: %s [-n levels] [-d difficulty] [-s seed] levels.c\n", argv[0]);
+				return 1;
+		}
+	}
+	if (optind != argc - 1 || levels == 0 || difficulty >= LEVEL_DIFFICULTIES) {
+		fprintf(stderr, "usage: %s [-n levels] [-d difficulty 0-%d] [-s seed] levels.c\n", argv[0], LEVEL_DIFFICULTIES - 1);
+		return 1;
+	}
+
+	FILE *out = fopen(argv[optind], "w");
+	if (out == NULL) {
+		perror(argv[optind]);
+		return 1;
+	}
+	fprintf(out, "//generated by host/levelpack.c (frogger_levels -n %u -d %u -s 0x%x), do not edit\n\n", levels, difficulty, packSeed);
+	fprintf(out, "#include \"levelgen.h\"\n\n");
+	fprintf(out, "const struct Level LEVEL_PACK[%u] = {\n", levels);
+
+	for (uint32_t i = 0; i < levels; i++) {
+		struct Prng stream;
+		struct Level level;
+
+		prngStream(&stream, packSeed, i);
+		uint32_t seed = prngNext(&stream);
+
+		clock_gettime(CLOCK_MONOTONIC, &start);
+		uint8_t drawn = levelGenerate(&level, seed, difficulty);
+		clock_gettime(CLOCK_MONOTONIC, &stop);
+
+		double seconds = (stop.tv_sec - start.tv_sec) + (stop.tv_nsec - start.tv_nsec) / 1e9;
+		total += seconds;
+		if (seconds > slowest) slowest = seconds;
+		drawnTotal += drawn;
+		crossingTotal += level.crossing;
+		if (level.difficulty != difficulty) eased++;
+		if (memcmp(&level, &LEVEL_FALLBACK, sizeof(level)) == 0) fallbacks++;
+
+		writeLevel(out, &level, seed, drawn);
+		fprintf(out, "%s\n", i < levels - 1 ? "," : "");
+	}
+	fprintf(out, "};\n");
+	fclose(out);
+
+	printf("levels: %u levels at difficulty %u in %.3f s: %.0f levels/s, %.0f us per level, slowest %.0f us\n",
+				 levels, difficulty, total, levels / total, total / levels * 1e6, slowest * 1e6);
+	printf("levels: %.1f layouts drawn per level, %llu eased to a lower difficulty, %llu fallbacks, %.0f ticks per crossing\n",
+				 (double)drawnTotal / levels, (unsigned long long)eased, (unsigned long long)fallbacks, (double)crossingTotal / levels);
+
+	uint16_t crossing = levelSearch(&LEVEL_FALLBACK);
+	printf("levels: fallback level crossed in %u ticks (recorded %u)\n", crossing, LEVEL_FALLBACK.crossing);
+	return crossing == LEVEL_FALLBACK.crossing ? 0 : 1;
+}
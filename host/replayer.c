@@ -0,0 +1,119 @@
+//**************************************************
+//
+// Host-side replayer
+// Description: plays recorded games again through the game model and checks
+//              every checksum in their logs, as a regression and speed test
+//
+// Usage: frogger_replay [-r repeats] log [log ...]
+//
+// Each file holds one or more logs back to back, as a board writes them
+// (make run leaves build/screen<N>.rec). Only the game model is linked, so
+// replaying runs as fast as the simulation itself; -r replays every file
+// that many times to time it. A log cut off mid-game (the simulated board's
+// script ended first) is replayed up to the cut. The exit status is 1 if any
+// log is corrupt or a replayed game differs from its recording.
+//
+//**************************************************
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "replay.h"
+
+//logs replayed, by how they ended (REPLAY_DONE, REPLAY_CUT, REPLAY_MISMATCH, REPLAY_CORRUPT)
+static uint64_t results[REPLAY_CORRUPT + 1];
+static uint64_t ticks = 0, radio = 0, checks = 0;
+
+/* Reads a whole file into memory */
+static uint8_t *load(const char *path, uint32_t *size) {
+	FILE *file = fopen(path, "rb");
+	uint8_t *data;
+	long length;
+
+	if (file == NULL) return NULL;
+	fseek(file, 0, SEEK_END);
+	length = ftell(file);
+	fseek(file, 0, SEEK_SET);
+	data = malloc(length > 0 ? length : 1);
+	*size = fread(data, 1, length, file);
+	fclose(file);
+	return data;
+}
+
+/* Replays every log in a stream; reports the ones that failed when report is set */
+static void replayAll(const char *path, const uint8_t *data, uint32_t size, bool report) {
+	struct ReplayReader reader = {data, size, 0};
+	struct Game game;
+	uint32_t index = 0;
+
+	while (reader.pos < reader.size) {
+		uint8_t result;
+
+		if (!replayOpen(&reader, &game)) {
+			results[REPLAY_CORRUPT]++;
+			if (report) printf("replay: %s: no log at byte %u\n", path, reader.pos);
+			return;
+		}
+		while ((result = replayStep(&reader, &game)) == REPLAY_STEPPED);
+
+		results[result]++;
+		ticks += game.tick;
+		radio += reader.radio;
+		checks += reader.checks;
+		if (report && (result == REPLAY_MISMATCH || result == REPLAY_CORRUPT)) {
+			printf("replay: %s: log %u (seed 0x%08x, %u players) %s at tick %u\n", path, index, reader.seed, reader.numPlayers,
+						 result == REPLAY_MISMATCH ? "differs from its recording" : "is corrupt", game.tick);
+		}
+		//the next log starts after this one's last record, which a game that went wrong does not reach
+		if (result == REPLAY_MISMATCH || result == REPLAY_CORRUPT) return;
+		index++;
+	}
+}
+
+int main(int argc, char **argv) {
+	struct timespec start, stop;
+	uint32_t repeats = 1;
+	uint64_t bytes = 0;
+	int opt;
+
+	while ((opt = getopt(argc, argv, "r:")) != -1) {
+		switch (opt) {
+			case 'r': repeats = strtoul(optarg, NULL, 0); break;
+			default:
+				fprintf(stderr, "usage: %s [-r repeats] log [log ...]\n", argv[0]);
+				return 1;
+		}
+	}
+	if (optind == argc || repeats == 0) {
+		fprintf(stderr, "usage: %s [-r repeats] log [log ...]\n", argv[0]);
+		return 1;
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (int i = optind; i < argc; i++) {
+		uint32_t size;
+		uint8_t *data = load(argv[i], &size);
+
+		if (data == NULL) {
+			printf("replay: %s: cannot read\n", argv[i]);
+			results[REPLAY_CORRUPT]++;
+			continue;
+		}
+		bytes += (uint64_t)size * repeats;
+		for (uint32_t repeat = 0; repeat < repeats; repeat++) replayAll(argv[i], data, size, repeat == 0);
+		free(data);
+	}
+	clock_gettime(CLOCK_MONOTONIC, &stop);
+
+	double seconds = (stop.tv_sec - start.tv_sec) + (stop.tv_nsec - start.tv_nsec) / 1e9;
+	uint64_t logs = results[REPLAY_DONE] + results[REPLAY_CUT] + results[REPLAY_MISMATCH] + results[REPLAY_CORRUPT];
+	printf("replay: %llu logs: %llu finished, %llu cut off, %llu differ, %llu corrupt; %llu checksums matched\n",
+				 (unsigned long long)logs, (unsigned long long)results[REPLAY_DONE], (unsigned long long)results[REPLAY_CUT],
+				 (unsigned long long)results[REPLAY_MISMATCH], (unsigned long long)results[REPLAY_CORRUPT], (unsigned long long)checks);
+	printf("replay: %llu ticks and %llu radio words from %llu bytes (%.2f bytes/tick) in %.3f s: %.0f logs/s, %.2f M ticks/s\n",
+				 (unsigned long long)ticks, (unsigned long long)radio, (unsigned long long)bytes, ticks ? (double)bytes / ticks : 0.0,
+				 seconds, logs / seconds, ticks / seconds / 1e6);
+	return results[REPLAY_MISMATCH] || results[REPLAY_CORRUPT] ? 1 : 0;
+}
@@ -0,0 +1,72 @@
+//**************************************************
+//
+// Host-side simulator launcher
+// Description: starts one process per simulated board, each running the
+//              game's main() against the simulated HAL and sharing one
+//              simulated radio channel
+//
+// Usage: frogger_sim [-d dump_prefix] [-n boards] script0 [script1 ...]
+//
+// With -n, more boards than scripts can be started for scale tests: the
+// scripts are handed out in turn, and each time a script is reused it starts
+// SIM_STAGGER_MS later so the boards do not all act at the same moment.
+//
+//**************************************************
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "ece210_sim.h"
+
+//the game's main(), renamed when main.c is compiled for the host
+int frogger_main(void);
+
+int main(int argc, char **argv) {
+	const char *dumpPrefix = NULL;
+	pid_t pids[SIM_MAX_BOARDS];
+	uint8_t boards = 0, scripts;
+	int opt;
+
+	while ((opt = getopt(argc, argv, "d:n:")) != -1) {
+		if (opt == 'd') {
+			dumpPrefix = optarg;
+		} else if (opt == 'n') {
+			boards = atoi(optarg);
+		} else {
+			fprintf(stderr, "usage: %s [-d dump_prefix] [-n boards] script0 [script1 ...]\n", argv[0]);
+			return 1;
+		}
+	}
+	scripts = argc - optind;
+	if (boards == 0) boards = scripts;
+	if (scripts == 0 || argc - optind > SIM_MAX_BOARDS || boards > SIM_MAX_BOARDS) {
+		fprintf(stderr, "usage: %s [-d dump_prefix] [-n boards] script0 [script1 ...] (up to %d boards)\n", argv[0], SIM_MAX_BOARDS);
+		return 1;
+	}
+
+	//start one process per board
+	simEtherCreate(boards);
+	fflush(stdout);
+	for (uint8_t i = 0; i < boards; i++) {
+		pids[i] = fork();
+		if (pids[i] == 0) {
+			simInit(i, argv[optind + i % scripts], i / scripts * SIM_STAGGER_MS, dumpPrefix);
+			frogger_main();
+			exit(0);
+		}
+	}
+
+	//wait for every board; a board that dies must not hold the others' radios back
+	int failed = 0;
+	for (uint8_t done = 0; done < boards; done++) {
+		int status;
+		pid_t pid = wait(&status);
+		for (uint8_t i = 0; i < boards; i++) {
+			if (pids[i] == pid) simEtherRelease(i);
+		}
+		if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) failed = 1;
+	}
+	return failed;
+}
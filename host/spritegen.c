@@ -0,0 +1,151 @@
+//**************************************************
+//
+// Sprite table generator
+// Description: run-length encodes every 1-bit bitmap in Images.c, in the color
+//              the game draws it with, into opaque and transparent runs and
+//              writes them out as Sprites.c/Sprites.h (run by "make sprites";
+//              the output is checked in so the Keil build does not need this tool)
+//
+// Usage: spritegen Sprites.c Sprites.h
+//
+// A run byte packs a transparent run and the opaque run after it, and a row
+// the same as the one above is a single byte, so the runs come out smaller
+// than the 1-bit bitmaps they replace (the game links only the runs). Sprites
+// drawn from the same bitmap in another color share its runs.
+//
+//**************************************************
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "Images.h"
+
+//one sprite to generate: a bitmap from Images.c in one color scheme
+struct SpriteSource {
+	const char *name;							//name of the generated SpriteData
+	const uint8_t *bitmap;				//bitmap from Images.c
+	uint8_t width;								//width of the bitmap [pixels]
+	uint8_t height;								//height of the bitmap [pixels]
+	uint16_t color;								//color of the set bits (clear bits are transparent)
+};
+
+static const struct SpriteSource sources[] = {
+	{"FROG_UP_SPRITE", FROG_BITMAP_UP, FROG_BITMAP_UP_WIDTH, FROG_BITMAP_UP_HEIGHT, FROG_FOREGROUND_COLOR},
+	{"FROG_RIGHT_SPRITE", FROG_BITMAP_RIGHT, FROG_BITMAP_RIGHT_WIDTH, FROG_BITMAP_RIGHT_HEIGHT, FROG_FOREGROUND_COLOR},
+	{"FROG_LEFT_SPRITE", FROG_BITMAP_LEFT, FROG_BITMAP_LEFT_WIDTH, FROG_BITMAP_LEFT_HEIGHT, FROG_FOREGROUND_COLOR},
+	{"FROG_DOWN_SPRITE", FROG_BITMAP_DOWN, FROG_BITMAP_DOWN_WIDTH, FROG_BITMAP_DOWN_HEIGHT, FROG_FOREGROUND_COLOR},
+	{"FROG2_SPRITE", FROG_BITMAP_UP, FROG_BITMAP_UP_WIDTH, FROG_BITMAP_UP_HEIGHT, FROG2_FOREGROUND_COLOR},
+	{"CAR1_SPRITE", CAR1_BITMAP, CAR1_BITMAP_WIDTH, CAR1_BITMAP_HEIGHT, CAR1_FOREGROUND_COLOR},
+	{"RACECAR_SPRITE", RACECAR_BITMAP, RACECAR_BITMAP_WIDTH, RACECAR_BITMAP_HEIGHT, RACECAR_FOREGROUND_COLOR},
+	{"TRUCK_SPRITE", TRUCK_BITMAP, TRUCK_BITMAP_WIDTH, TRUCK_BITMAP_HEIGHT, TRUCK_FOREGROUND_COLOR},
+	{"LOG_SPRITE", LOG_BITMAP, LOG_BITMAP_WIDTH, LOG_BITMAP_HEIGHT, LOG_FOREGROUND_COLOR},
+};
+
+#define NUM_SOURCES (sizeof(sources) / sizeof(sources[0]))
+
+static int bitSet(const struct SpriteSource *source, int col, int row) {
+	return source->bitmap[row * ((source->width + 7) / 8) + col / 8] & (0x80 >> (col % 8));
+}
+
+static int rowsEqual(const struct SpriteSource *source, int row1, int row2) {
+	for (int col = 0; col < source->width; col++) {
+		if ((bitSet(source, col, row1) != 0) != (bitSet(source, col, row2) != 0)) return 0;
+	}
+	return 1;
+}
+
+/* Writes a sprite's runs, or points it at the runs of an earlier sprite drawn from the same bitmap;
+ * returns the bytes of runs written */
+static int writeSprite(FILE *out, const struct SpriteSource *source, const struct SpriteSource *shared) {
+	int bytes = 0;
+
+	if (shared != NULL) {
+		fprintf(out, "//runs shared with %s\r\n", shared->name);
+		fprintf(out, "const struct SpriteData %s = {%d, %d, 0x%04X, %s_RUNS};\r\n\r\n",
+						source->name, source->width, source->height, source->color, shared->name);
+		return 0;
+	}
+
+	fprintf(out, "static const uint8_t %s_RUNS[] = {", source->name);
+	for (int row = 0; row < source->height; row++) {
+		int col = 0;
+		fprintf(out, "\r\n\t");
+		if (row > 0 && rowsEqual(source, row, row - 1)) {
+			fprintf(out, "0x%02X,", SPRITE_ROW_REPEAT);
+			bytes++;
+			continue;
+		}
+		while (col < source->width) {
+			int skip = 0, draw = 0;
+			while (col < source->width && !bitSet(source, col, row) && skip < SPRITE_MAX_SKIP) { col++; skip++; }
+			//a longer gap is carried on by the next byte; the last gap of a row is left to the row end
+			if (col < source->width && !bitSet(source, col, row)) {
+				fprintf(out, "0x%02X, ", skip << SPRITE_SKIP_SHIFT);
+				bytes++;
+				continue;
+			}
+			if (col == source->width) break;
+			while (col < source->width && bitSet(source, col, row) && draw < SPRITE_MAX_DRAW) { col++; draw++; }
+			fprintf(out, "0x%02X, ", skip << SPRITE_SKIP_SHIFT | draw);
+			bytes++;
+		}
+		fprintf(out, "0x%02X,", SPRITE_ROW_END);
+		bytes++;
+	}
+	fprintf(out, "\r\n};\r\n\r\n");
+
+	fprintf(out, "//%d bytes (%d as a bitmap)\r\n", bytes, (source->width + 7) / 8 * source->height);
+	fprintf(out, "const struct SpriteData %s = {%d, %d, 0x%04X, %s_RUNS};\r\n\r\n",
+					source->name, source->width, source->height, source->color, source->name);
+	return bytes;
+}
+
+int main(int argc, char **argv) {
+	FILE *source, *header;
+	int runBytes = 0, bitmapBytes = 0;
+
+	if (argc != 3) {
+		fprintf(stderr, "usage: %s Sprites.c Sprites.h\n", argv[0]);
+		return 1;
+	}
+	source = fopen(argv[1], "wb");
+	header = fopen(argv[2], "wb");
+	if (source == NULL || header == NULL) {
+		perror("spritegen");
+		return 1;
+	}
+
+	fprintf(header, "//**************************************************\r\n"
+									"//\r\n"
+									"// Generated by host/spritegen.c from Images.c (make -C host sprites); do not edit\r\n"
+									"//\r\n"
+									"//**************************************************\r\n\r\n"
+									"#ifndef __SPRITES_H__\r\n#define __SPRITES_H__\r\n\r\n#include \"Images.h\"\r\n\r\n");
+	fprintf(source, "//**************************************************\r\n"
+									"//\r\n"
+									"// Generated by host/spritegen.c from Images.c (make -C host sprites); do not edit\r\n"
+									"//\r\n"
+									"//**************************************************\r\n\r\n"
+									"#include \"Sprites.h\"\r\n\r\n");
+
+	for (size_t i = 0; i < NUM_SOURCES; i++) {
+		const struct SpriteSource *shared = NULL;
+
+		if (sources[i].width > SPRITE_MAX_WIDTH) {
+			fprintf(stderr, "spritegen: %s is wider than %d pixels\n", sources[i].name, SPRITE_MAX_WIDTH);
+			return 1;
+		}
+		for (size_t j = 0; j < i && shared == NULL; j++) {
+			if (sources[j].bitmap == sources[i].bitmap) shared = &sources[j];
+		}
+		if (shared == NULL) bitmapBytes += (sources[i].width + 7) / 8 * sources[i].height;
+		fprintf(header, "extern const struct SpriteData %s;\r\n", sources[i].name);
+		runBytes += writeSprite(source, &sources[i], shared);
+	}
+	fprintf(header, "\r\n#endif\r\n");
+
+	fclose(source);
+	fclose(header);
+	printf("sprites: %d bytes of runs in place of %d bytes of bitmaps\n", runBytes, bitmapBytes);
+	return 0;
+}
@@ -0,0 +1,103 @@
+//**************************************************
+//
+// Authors: Caleb Reiter, Alex Fanner, Chris Chu, Kao Yang
+// Description: Debounced, timestamped button and joystick events
+//
+// Every ece210_buttons_read() is an I2C transaction with the IO expander, and
+// the game used to make several of them in a row to find out which button was
+// down, and more in tight loops while waiting for one. The expander raises
+// the GPIOF interrupt (AlertButtons) whenever a button changes, so the buttons
+// are read once per change instead: the first change is taken right away and
+// any bounce within INPUT_DEBOUNCE_MS is read as one change once it settles.
+// The joystick is sampled every INPUT_JOYSTICK_MS. Changes go into a ring
+// buffer with one writer (inputTask) and one reader, so the reader never
+// needs to lock out the writer.
+//
+//**************************************************
+
+#include "input.h"
+#include "profile.h"
+
+/***************************************************
+ * Global Variables
+ **************************************************/
+
+static struct InputEvent events[INPUT_QUEUE_SIZE];		//queued events
+static volatile uint8_t head = 0;											//index of the next event written (only inputTask moves it)
+static volatile uint8_t tail = 0;											//index of the next event read (only the reader moves it)
+static uint8_t buttons = 0;														//buttons held down as of the last read
+static uint8_t joystick = PS2_CENTER;									//joystick direction as of the last sample
+static uint32_t settleMs = 0;													//time the last button change is over bouncing [ms]
+static uint32_t sampleMs = 0;													//time the joystick is sampled next [ms]
+
+/***************************************************
+ * Helper Functions
+ **************************************************/
+
+static void push(uint8_t type, uint8_t value, uint32_t now) {
+	if ((uint8_t)(head - tail) == INPUT_QUEUE_SIZE) return;
+	struct InputEvent *event = &events[head % INPUT_QUEUE_SIZE];
+	event->type = type;
+	event->value = value;
+	event->timeMs = now;
+	head++;
+}
+
+/***************************************************
+ * Functions
+ **************************************************/
+
+void inputReset(void) {
+	AlertButtons = false;
+	buttons = ece210_buttons_read();
+	joystick = ece210_ps2_read_position();
+	settleMs = sampleMs = clockMs();
+	inputFlush();
+} //end inputReset()
+
+void inputFlush(void) {
+	tail = head;
+} //end inputFlush()
+
+bool inputPoll(struct InputEvent *event) {
+	if (tail == head) return false;
+	*event = events[tail % INPUT_QUEUE_SIZE];
+	tail++;
+	return true;
+} //end inputPoll()
+
+uint8_t inputButtons(void) {
+	return buttons;
+} //end inputButtons()
+
+uint8_t inputJoystick(void) {
+	return joystick;
+} //end inputJoystick()
+
+uint32_t inputTask(void) {
+	uint32_t now = clockMs();
+	PROFILE_BEGIN(PROFILE_INPUT);
+
+	//read the buttons once per interrupt, leaving interrupts raised by bouncing for when it has settled
+	if (AlertButtons && (int32_t)(now - settleMs) >= 0) {
+		AlertButtons = false;
+		uint8_t read = ece210_buttons_read();
+		uint8_t changed = read ^ buttons;
+		for (uint8_t button = INPUT_UP; button <= INPUT_RIGHT; button <<= 1) {
+			if (changed & button) push(read & button ? INPUT_PRESS : INPUT_RELEASE, button, now);
+		}
+		buttons = read;
+		if (changed) settleMs = now + INPUT_DEBOUNCE_MS;
+	}
+
+	//sample the joystick at a steady rate
+	if ((int32_t)(now - sampleMs) >= 0) {
+		uint8_t direction = ece210_ps2_read_position();
+		if (direction != joystick) push(INPUT_JOYSTICK, direction, now);
+		joystick = direction;
+		sampleMs = now + INPUT_JOYSTICK_MS;
+	}
+
+	PROFILE_END(PROFILE_INPUT);
+	return INPUT_POLL_MS;
+} //end inputTask()
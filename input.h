@@ -0,0 +1,62 @@
+//**************************************************
+//
+// Authors: Caleb Reiter, Alex Fanner, Chris Chu, Kao Yang
+// Description: Debounced, timestamped button and joystick events
+//
+//**************************************************
+
+#ifndef __INPUT_H__
+#define __INPUT_H__
+
+#include "ece210_api.h"
+#include "tasks.h"
+
+#define INPUT_POLL_MS 1							//time between two checks for a button interrupt [ms]
+#define INPUT_DEBOUNCE_MS 20				//time a button change must settle before the buttons are read again [ms]
+#define INPUT_JOYSTICK_MS 4					//time between two joystick samples [ms]
+#define INPUT_QUEUE_SIZE 16					//events the queue holds, newer events are dropped while it is full (a power of 2) [events]
+
+#define INPUT_UP 0x01								//up button (as read from the IO expander)
+#define INPUT_DOWN 0x02							//down button
+#define INPUT_LEFT 0x04							//left button
+#define INPUT_RIGHT 0x08						//right button
+
+#define INPUT_PRESS 0								//a button was pressed
+#define INPUT_RELEASE 1							//a button was released
+#define INPUT_JOYSTICK 2						//the joystick moved to another direction
+
+//something the player did
+struct InputEvent {
+	uint8_t type;									//what happened (INPUT_PRESS, INPUT_RELEASE, INPUT_JOYSTICK)
+	uint8_t value;								//the button (INPUT_UP, ...) or the joystick's new direction (PS2_*)
+	uint32_t timeMs;							//time it was seen [ms]
+};
+
+/* Reads the buttons and the joystick as they are and empties the queue; call once before starting inputTask */
+void inputReset(void);
+
+/* Drops every queued event (the buttons and joystick keep their state) */
+void inputFlush(void);
+
+/* Takes the oldest queued event
+ * Parameters:
+ * 	-*event: filled with the event
+ * Returns:
+ * 	-True if there was an event
+ * 	-False if the queue is empty
+ */
+bool inputPoll(struct InputEvent *event);
+
+/* Returns the buttons held down as of the last read [INPUT_UP | INPUT_DOWN | ...] */
+uint8_t inputButtons(void);
+
+/* Returns the joystick's direction as of the last sample [one of PS2_CENTER, PS2_RIGHT, PS2_UP, PS2_LEFT, PS2_DOWN] */
+uint8_t inputJoystick(void);
+
+/* Reads the buttons once after each interrupt and samples the joystick (always scheduled)
+ * Returns:
+ * 	-the time until the next check [ms]
+ */
+uint32_t inputTask(void);
+
+#endif
@@ -0,0 +1,34 @@
+//**************************************************
+// 
+// Authors: Caleb Reiter, Alex Fanner, Chris Chu, Kao Yang
+// Description: Screen and playfield geometry shared by the game modules
+//
+//**************************************************
+
+#ifndef __LAYOUT_H__
+#define __LAYOUT_H__
+
+#define LCD_WIDTH 240			//LCD width [pixels]
+#define LCD_HEIGHT 320		//LCD height [pixels]
+
+/* Possible positions of the player are represented as a GRID_WIDTH by GRID_HEIGHT grid; each move
+ * brings the player from one grid location to another, and the player will never be in more
+ * than one grid location at any given time
+ */
+#define GRID_SIZE	30			//height/width of each grid location [pixels]
+#define GRID_WIDTH 7			//width of grid [number of grid locations]
+#define GRID_HEIGHT	10		//height of grid [number of grid locations]
+
+#define TOP_BORDER ((LCD_HEIGHT - GRID_HEIGHT * GRID_SIZE) / 2)		//position of top border [pixels]
+#define LEFT_BORDER ((LCD_WIDTH - GRID_WIDTH * GRID_SIZE) / 2)		//position of left border [pixels]
+#define RIGHT_BORDER (LEFT_BORDER + GRID_WIDTH * GRID_SIZE)				//position of right border [pixels]
+#define BOTTOM_BORDER (TOP_BORDER + GRID_HEIGHT * GRID_SIZE)			//position of bottom border [pixels]
+
+#define GAME_WIDTH (RIGHT_BORDER - LEFT_BORDER)				//width of game screen [pixels]
+#define GAME_HEIGHT (BOTTOM_BORDER - TOP_BORDER)			//height of game screen [pixels]
+
+#define WATER_ROWS 3															//number of rows of logs [number of rows]
+#define CAR_ROWS (GRID_HEIGHT - WATER_ROWS - 2)		//number of rows of cars [number of rows]
+#define ENTITY_ROWS (WATER_ROWS + CAR_ROWS)				//number of rows containing entities (excludes top and bottom rows) [number of rows]
+
+#endif
@@ -0,0 +1,225 @@
+//**************************************************
+//
+// Authors: Caleb Reiter, Alex Fanner, Chris Chu, Kao Yang
+// Description: Framebuffer and animations for the LEDs along the top of the board
+//
+// ece210_ws2812b_write() changes one LED and sends the whole chain again, so
+// setting every LED took eight transfers, each timing-critical bit-banging
+// that holds the CPU away from the LCD and the radio. The LEDs are drawn into
+// a framebuffer instead, and the LED task sends the whole chain in one
+// transfer only when a frame differs from the one last sent. Animations are
+// stepped by the same task, so nothing waits for the LEDs.
+//
+//**************************************************
+
+#include "leds.h"
+#include "profile.h"
+
+#ifdef HOST_SIM
+#include "ece210_sim.h"
+#else
+//the board library's chain writer behind ece210_ws2812b_write() (its header is not shipped with the API)
+extern void WS2812B_write(uint32_t port_base_addr, uint8_t *led_array_ptr, uint16_t num_leds);
+#define LEDS_PORT (GPIOD_BASE + 0x3FC)				//data register of the port the chain hangs off
+#endif
+
+/***************************************************
+ * Structures
+ **************************************************/
+
+#define ANIMATION_NONE 0				//the frame only changes when it is drawn into
+#define ANIMATION_KEYFRAMES 1		//keyframes are played on every LED
+#define ANIMATION_RAINBOW 2			//a rainbow runs along the LEDs
+
+//animation being played
+struct Animation {
+	uint8_t type;																		//what is played (ANIMATION_*)
+	struct LedKeyframe keyframes[LEDS_MAX_KEYFRAMES];		//keyframes played (ANIMATION_KEYFRAMES)
+	uint8_t count;																	//number of keyframes, or of rainbow steps per run
+	uint8_t repeats;																//runs left, the current one included
+	uint8_t index;																	//current keyframe, or rainbow step
+	uint8_t level;																	//brightest level of the rainbow
+	uint16_t stepMs;																//time of one rainbow step [ms]
+	uint32_t startMs;																//time the current keyframe or step began [ms]
+	struct LedColor from;														//color the current keyframe fades from
+};
+
+/***************************************************
+ * Global Variables
+ **************************************************/
+
+static struct LedColor frame[LEDS_COUNT];				//the LEDs as they should be
+static struct LedColor sent[LEDS_COUNT];				//the LEDs as they were last sent
+static bool sentValid = false;									//if anything has been sent yet
+static struct Animation animation;							//animation being played
+
+/***************************************************
+ * Helper Functions
+ **************************************************/
+
+static void fill(uint8_t red, uint8_t green, uint8_t blue) {
+	for (uint8_t led = 0; led < LEDS_COUNT; led++) {
+		frame[led].red = red;
+		frame[led].green = green;
+		frame[led].blue = blue;
+	}
+}
+
+static uint8_t blend(uint8_t from, uint8_t to, uint32_t elapsed, uint32_t length) {
+	return from + ((int32_t)to - from) * (int32_t)elapsed / (int32_t)length;
+}
+
+/* Sends the frame to the chain in one transfer if it differs from the last one sent */
+static void commit(void) {
+	if (sentValid && memcmp(frame, sent, sizeof(frame)) == 0) return;
+
+#ifdef HOST_SIM
+	simLedsWrite((const uint8_t *)frame, LEDS_COUNT);
+#else
+	WS2812B_write(LEDS_PORT, (uint8_t *)frame, LEDS_COUNT);
+#endif
+	memcpy(sent, frame, sizeof(frame));
+	sentValid = true;
+} //end commit()
+
+/* Starts playing the keyframe at animation.index from the colors now in the frame */
+static void beginKeyframe(uint32_t now) {
+	animation.from = frame[0];
+	animation.startMs = now;
+} //end beginKeyframe()
+
+/* Draws the current keyframe into the frame
+ * Returns:
+ * 	-the time until the frame changes again [ms], or TASK_DONE once the keyframes are over
+ */
+static uint32_t stepKeyframes(uint32_t now) {
+	//move past every keyframe that is over
+	while (now - animation.startMs >= animation.keyframes[animation.index].ms) {
+		const struct LedKeyframe *done = &animation.keyframes[animation.index];
+		fill(done->red, done->green, done->blue);
+		uint32_t endMs = animation.startMs + done->ms;
+		if (++animation.index == animation.count) {
+			animation.index = 0;
+			if (--animation.repeats == 0) return TASK_DONE;
+		}
+		beginKeyframe(endMs);
+	}
+
+	const struct LedKeyframe *keyframe = &animation.keyframes[animation.index];
+	uint32_t elapsed = now - animation.startMs;
+	if (keyframe->mode == LED_FADE) {
+		fill(blend(animation.from.red, keyframe->red, elapsed, keyframe->ms),
+				 blend(animation.from.green, keyframe->green, elapsed, keyframe->ms),
+				 blend(animation.from.blue, keyframe->blue, elapsed, keyframe->ms));
+		return keyframe->ms - elapsed < LEDS_FADE_MS ? keyframe->ms - elapsed : LEDS_FADE_MS;
+	}
+	fill(keyframe->red, keyframe->green, keyframe->blue);
+	return keyframe->ms - elapsed;
+} //end stepKeyframes()
+
+/* Draws the current rainbow step into the frame: each LED is further round the color wheel than the one before
+ * Returns:
+ * 	-the time until the rainbow moves on [ms], or TASK_DONE once it is over
+ */
+static uint32_t stepRainbow(uint32_t now) {
+	while (now - animation.startMs >= animation.stepMs) {
+		animation.startMs += animation.stepMs;
+		if (++animation.index == animation.count) {
+			animation.index = 0;
+			if (--animation.repeats == 0) {
+				fill(0, 0, 0);
+				return TASK_DONE;
+			}
+		}
+	}
+
+	for (uint8_t led = 0; led < LEDS_COUNT; led++) {
+		//hue in [0, 3 * LEDS_COUNT): red to green, green to blue, blue back to red
+		uint8_t hue = (led + LEDS_COUNT * 3 - animation.index) % (LEDS_COUNT * 3);
+		uint8_t rise = animation.level * (hue % LEDS_COUNT) / LEDS_COUNT;
+		uint8_t fall = animation.level - rise;
+		switch (hue / LEDS_COUNT) {
+			case 0: frame[led].red = fall; frame[led].green = rise; frame[led].blue = 0; break;
+			case 1: frame[led].red = 0; frame[led].green = fall; frame[led].blue = rise; break;
+			default: frame[led].red = rise; frame[led].green = 0; frame[led].blue = fall; break;
+		}
+	}
+	return animation.stepMs - (now - animation.startMs);
+} //end stepRainbow()
+
+/***************************************************
+ * Functions
+ **************************************************/
+
+void ledsSet(uint8_t led, uint8_t red, uint8_t green, uint8_t blue) {
+	animation.type = ANIMATION_NONE;
+	frame[led].red = red;
+	frame[led].green = green;
+	frame[led].blue = blue;
+	taskStart(ledsTask, 0);
+} //end ledsSet()
+
+void ledsFill(uint8_t red, uint8_t green, uint8_t blue) {
+	animation.type = ANIMATION_NONE;
+	fill(red, green, blue);
+	taskStart(ledsTask, 0);
+} //end ledsFill()
+
+void ledsPlay(const struct LedKeyframe *keyframes, uint8_t count, uint8_t repeats) {
+	if (count > LEDS_MAX_KEYFRAMES) count = LEDS_MAX_KEYFRAMES;
+	if (count == 0 || repeats == 0) return;
+
+	memcpy(animation.keyframes, keyframes, count * sizeof(struct LedKeyframe));
+	animation.type = ANIMATION_KEYFRAMES;
+	animation.count = count;
+	animation.repeats = repeats;
+	animation.index = 0;
+	beginKeyframe(clockMs());
+	taskStart(ledsTask, 0);
+} //end ledsPlay()
+
+void ledsBlink(uint8_t red, uint8_t green, uint8_t blue, uint16_t onMs, uint16_t offMs, uint8_t blinks) {
+	struct LedKeyframe keyframes[2] = {
+		{red, green, blue, LED_HOLD, onMs},
+		{0, 0, 0, LED_HOLD, offMs}
+	};
+	ledsPlay(keyframes, 2, blinks);
+} //end ledsBlink()
+
+void ledsRainbow(uint8_t level, uint16_t stepMs, uint8_t runs) {
+	if (runs == 0) return;
+
+	animation.type = ANIMATION_RAINBOW;
+	animation.count = LEDS_COUNT * 3;
+	animation.repeats = runs;
+	animation.index = 0;
+	animation.level = level;
+	animation.stepMs = stepMs;
+	animation.startMs = clockMs();
+	taskStart(ledsTask, 0);
+} //end ledsRainbow()
+
+void ledsStop(void) {
+	animation.type = ANIMATION_NONE;
+} //end ledsStop()
+
+bool ledsBusy(void) {
+	return animation.type != ANIMATION_NONE;
+} //end ledsBusy()
+
+uint32_t ledsTask(void) {
+	uint32_t delayMs = TASK_DONE;
+	uint32_t now = clockMs();
+	PROFILE_BEGIN(PROFILE_LEDS);
+
+	if (animation.type == ANIMATION_KEYFRAMES) {
+		delayMs = stepKeyframes(now);
+	} else if (animation.type == ANIMATION_RAINBOW) {
+		delayMs = stepRainbow(now);
+	}
+	if (delayMs == TASK_DONE) animation.type = ANIMATION_NONE;
+
+	commit();
+	PROFILE_END(PROFILE_LEDS);
+	return delayMs;
+} //end ledsTask()
@@ -0,0 +1,97 @@
+//**************************************************
+//
+// Authors: Caleb Reiter, Alex Fanner, Chris Chu, Kao Yang
+// Description: Framebuffer and animations for the LEDs along the top of the board
+//
+//**************************************************
+
+#ifndef __LEDS_H__
+#define __LEDS_H__
+
+#include "ece210_api.h"
+#include "tasks.h"
+
+#define LEDS_COUNT 8								//LEDs along the top of the board [LEDs]
+#define LEDS_FADE_MS 20							//time between two frames of a fade [ms]
+#define LEDS_MAX_KEYFRAMES 4				//keyframes one animation can have [keyframes]
+
+#define LED_HOLD 0									//the LEDs jump to the keyframe's color and keep it
+#define LED_FADE 1									//the LEDs fade from the previous color to the keyframe's
+
+//color of one LED, in the order the chain takes it
+struct LedColor {
+	uint8_t green;								//green level
+	uint8_t red;									//red level
+	uint8_t blue;									//blue level
+};
+
+//one step of an animation of every LED at once
+struct LedKeyframe {
+	uint8_t red;									//red level reached
+	uint8_t green;								//green level reached
+	uint8_t blue;									//blue level reached
+	uint8_t mode;									//how the color is reached (LED_HOLD, LED_FADE)
+	uint16_t ms;									//length of the keyframe [ms]
+};
+
+/* Sets one LED, stopping any animation; the frame is sent once the LED task runs
+ * Parameters:
+ * 	-led: index of the LED [0, LEDS_COUNT)
+ * 	-red: red level
+ * 	-green: green level
+ * 	-blue: blue level
+ */
+void ledsSet(uint8_t led, uint8_t red, uint8_t green, uint8_t blue);
+
+/* Sets every LED to the same color, stopping any animation; the frame is sent once the LED task runs
+ * Parameters:
+ * 	-red: red level
+ * 	-green: green level
+ * 	-blue: blue level
+ */
+void ledsFill(uint8_t red, uint8_t green, uint8_t blue);
+
+/* Plays keyframes on every LED, replacing any animation
+ * Parameters:
+ * 	-*keyframes: the keyframes (copied, at most LEDS_MAX_KEYFRAMES)
+ * 	-count: number of keyframes
+ * 	-repeats: times the keyframes are played
+ */
+void ledsPlay(const struct LedKeyframe *keyframes, uint8_t count, uint8_t repeats);
+
+/* Blinks every LED, replacing any animation (the LEDs are left off)
+ * Parameters:
+ * 	-red: red level while on
+ * 	-green: green level while on
+ * 	-blue: blue level while on
+ * 	-onMs: time the LEDs stay on [ms]
+ * 	-offMs: time the LEDs stay off [ms]
+ * 	-blinks: number of blinks
+ */
+void ledsBlink(uint8_t red, uint8_t green, uint8_t blue, uint16_t onMs, uint16_t offMs, uint8_t blinks);
+
+/* Runs a rainbow along the LEDs, replacing any animation (the LEDs are left off)
+ * Parameters:
+ * 	-level: brightest level of any color
+ * 	-stepMs: time the rainbow takes to move one LED along [ms]
+ * 	-runs: times the rainbow goes all the way along the LEDs
+ */
+void ledsRainbow(uint8_t level, uint16_t stepMs, uint8_t runs);
+
+/* Stops any animation, leaving the LEDs as they are */
+void ledsStop(void);
+
+/* Checks if an animation is playing
+ * Returns:
+ * 	-True until the animation's last frame has been sent
+ * 	-False otherwise
+ */
+bool ledsBusy(void);
+
+/* Moves the animation on and sends the frame if any LED changed (started by the functions above)
+ * Returns:
+ * 	-the time until the next frame [ms], or TASK_DONE once nothing is left to send
+ */
+uint32_t ledsTask(void);
+
+#endif
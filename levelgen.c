@@ -0,0 +1,409 @@
+//**************************************************
+//
+// Authors: Caleb Reiter, Alex Fanner, Chris Chu, Kao Yang
+// Description: Lane layouts for a difficulty, checked to be crossable
+//
+// A difficulty sets how many cars share a road lane and how fast the lanes
+// move. Each car starts a random distance into an equal share of its lane,
+// with at least a car's width to spare, so cars stay apart when they wrap
+// around. Water lanes hold one log, since logs bounce off the borders at
+// speeds of their own and would pass through each other.
+//
+// Every layout is checked by a search over time: for each tick the lanes are
+// moved with the game's own entitiesAt() and the level's generator, and the
+// positions a player could stand on are kept as one bit per pixel of x in
+// each row. They are split by the frog's shape (facing up or down, or facing
+// sideways, which is narrower and placed further in) and by whether the
+// player has to return the joystick to center before its next hop. Each
+// tick, a player stays put or hops, the way movePlayer() moves it: a
+// sideways hop is checked against the border from the unsnapped position,
+// then snaps to a column and turns the frog sideways; an up or down hop turns
+// it up and snaps except out of the two top water rows. Positions on a car
+// or off every log are dropped, and positions on a log move with it. Cars
+// and log ends are kept LEVEL_MARGIN pixels away, to cover the pixel the
+// player's own sub-pixel position can differ from the log's, so the search
+// errs towards calling a layout uncrossable. A search ends when a position
+// reaches the top row or none is left.
+//
+// The generator runs a few search ticks per step so that the board keeps
+// polling the radio while it generates the level during the countdown. Its
+// work is bounded: a difficulty gets LEVEL_TRIES layouts, and once the
+// easiest runs out or LEVEL_BUDGET_TICKS search ticks are spent the level is
+// LEVEL_FALLBACK, which is known to be crossable.
+//
+//**************************************************
+
+#include "levelgen.h"
+
+#define LEVEL_WORDS 8								//words of one row of positions (one bit per pixel of x) [words]
+#define LEVEL_MARGIN 2							//distance kept from cars and log ends [pixels]
+#define SHAPE_UP 0									//the frog faces up or down
+#define SHAPE_SIDE 1								//the frog faces left or right
+#define LEVEL_SHAPES 2							//shapes of the frog [shapes]
+
+/***************************************************
+ * Structures
+ **************************************************/
+
+//settings of one difficulty
+struct Difficulty {
+	uint8_t minCars;							//fewest cars in a road lane
+	uint8_t maxCars;							//most cars in a road lane
+	uint16_t carMin;							//slowest car lane, Q8.8 [1/256 pixels per tick]
+	uint16_t carMax;							//fastest car lane, Q8.8 [1/256 pixels per tick]
+	uint16_t logMin;							//slowest log lane, Q8.8 [1/256 pixels per tick]
+	uint16_t logMax;							//fastest log lane, Q8.8 [1/256 pixels per tick]
+	uint16_t minCrossing;					//fewest ticks the crossing may take, so a level is not trivial for it [ticks]
+};
+
+//positions a player could stand on, by frog shape and row (one bit per pixel of the frog's x position)
+struct Reach {
+	uint32_t ready[LEVEL_SHAPES][GRID_HEIGHT][LEVEL_WORDS];			//the player may hop on the next tick
+	uint32_t landed[LEVEL_SHAPES][GRID_HEIGHT][LEVEL_WORDS];		//the player just hopped and must return to center first
+};
+
+/***************************************************
+ * Global Constants and Variables
+ **************************************************/
+
+static const struct Difficulty DIFFICULTIES[LEVEL_DIFFICULTIES] = {
+	{1, 1, 0x0040, 0x0100, 0x0040, 0x00C0, 0},
+	{1, 2, 0x0060, 0x0180, 0x0060, 0x0120, 40},
+	{2, 2, 0x0080, 0x0200, 0x0080, 0x0180, 60},
+	{2, 3, 0x00C0, 0x0200, 0x00C0, 0x0180, 80}
+};
+
+//frog sprite of each shape
+static const uint8_t SHAPE_SPRITES[LEVEL_SHAPES] = {SPRITE_FROG_UP, SPRITE_FROG_RIGHT};
+
+//level 1 of frogger_levels -d 0 -s 0x2 (seed 0x86cc40fc)
+const struct Level LEVEL_FALLBACK = {0, 56, {0xc92b875b, 34}, {
+	{1, PS2_RIGHT, 0x00bc, {3, 0, 0}, {142, 0, 0}},
+	{1, PS2_RIGHT, 0x0049, {3, 0, 0}, {112, 0, 0}},
+	{1, PS2_RIGHT, 0x0079, {3, 0, 0}, {84, 0, 0}},
+	{1, PS2_RIGHT, 0x00cd, {2, 0, 0}, {166, 0, 0}},
+	{1, PS2_LEFT, 0x00ea, {0, 0, 0}, {98, 0, 0}},
+	{1, PS2_RIGHT, 0x0075, {1, 0, 0}, {151, 0, 0}},
+	{1, PS2_LEFT, 0x00c7, {0, 0, 0}, {136, 0, 0}},
+	{1, PS2_RIGHT, 0x0047, {0, 0, 0}, {109, 0, 0}}
+}};
+
+//the search's working state is kept out of the board's small stack; the host's batch simulator
+//generates levels on several threads at once, so there each thread gets its own
+#ifdef HOST_SIM
+#define SCRATCH static _Thread_local
+#else
+#define SCRATCH static
+#endif
+
+SCRATCH struct EntityStore lanes;			//the lanes as they move
+SCRATCH struct Reach reach[2];				//positions after the last tick, and being worked out for the next
+SCRATCH uint8_t current;							//index of the positions after the last tick in reach
+SCRATCH uint16_t searched;						//ticks searched so far [ticks]
+
+/***************************************************
+ * Helper Functions
+ **************************************************/
+
+/* Returns the bits of word w that lie in [from, to] */
+static uint32_t rangeMask(uint8_t w, int16_t from, int16_t to) {
+	int16_t low = from - w * 32, high = to - w * 32;
+
+	if (high < 0 || low > 31 || low > high) return 0;
+	if (low < 0) low = 0;
+	if (high > 31) high = 31;
+	return (0xFFFFFFFFu >> (31 - high)) & (0xFFFFFFFFu << low);
+}
+
+/* Sets every bit in [from, to] that lies within a row */
+static void setRange(uint32_t *bits, int16_t from, int16_t to) {
+	for (uint8_t w = 0; w < LEVEL_WORDS; w++) bits[w] |= rangeMask(w, from, to);
+}
+
+/* Clears every bit in [from, to] that lies within a row */
+static void clearRange(uint32_t *bits, int16_t from, int16_t to) {
+	for (uint8_t w = 0; w < LEVEL_WORDS; w++) bits[w] &= ~rangeMask(w, from, to);
+}
+
+static bool anyRange(const uint32_t *bits, int16_t from, int16_t to) {
+	uint32_t any = 0;
+	for (uint8_t w = from / 32; w <= to / 32; w++) any |= bits[w] & rangeMask(w, from, to);
+	return any != 0;
+}
+
+static bool anyBits(const uint32_t *bits) {
+	uint32_t any = 0;
+	for (uint8_t w = 0; w < LEVEL_WORDS; w++) any |= bits[w];
+	return any != 0;
+}
+
+/* Adds the bits of in moved by delta pixels (less than 32 either way) to out */
+static void shiftInto(uint32_t *out, const uint32_t *in, int8_t delta) {
+	uint8_t d = delta < 0 ? -delta : delta;
+	for (uint8_t w = 0; w < LEVEL_WORDS; w++) {
+		if (d == 0) {
+			out[w] |= in[w];
+		} else if (delta > 0) {
+			out[w] |= in[w] << d | (w > 0 ? in[w - 1] >> (32 - d) : 0);
+		} else {
+			out[w] |= in[w] >> d | (w < LEVEL_WORDS - 1 ? in[w + 1] << (32 - d) : 0);
+		}
+	}
+}
+
+/* Returns the columns holding a position in [from, to] of a row, one bit per column */
+static uint8_t columns(const uint32_t *bits, int16_t from, int16_t to) {
+	uint8_t cols = 0;
+	for (uint8_t col = 0; col < GRID_WIDTH; col++) {
+		int16_t left = LEFT_BORDER + col * GRID_SIZE, right = left + GRID_SIZE - 1;
+		if (anyRange(bits, left > from ? left : from, right < to ? right : to)) cols |= 1 << col;
+	}
+	return cols;
+}
+
+/* Adds the positions a hop lands on: each column holding a position, snapped to the column's
+ * player position and moved shift columns sideways (like correctOffset()) */
+static void addSnapped(uint32_t *out, uint8_t cols, int8_t shift, uint8_t offset) {
+	cols = shift < 0 ? cols >> -shift : (cols << shift) & ((1 << GRID_WIDTH) - 1);
+	for (uint8_t col = 0; col < GRID_WIDTH; col++) {
+		int16_t x = LEFT_BORDER + col * GRID_SIZE + offset;
+		if (cols & (1 << col)) out[x / 32] |= 1u << (x % 32);
+	}
+}
+
+/* Keeps the positions of a row a player survives on after the lanes moved, moving the ones on a log with it */
+static void settle(uint32_t *bits, uint8_t row, const uint8_t *oldX, uint8_t width) {
+	uint32_t safe[LEVEL_WORDS] = {0};
+	uint32_t carried[LEVEL_WORDS] = {0};
+
+	if (row == 0 || row == GRID_HEIGHT - 1 || !anyBits(bits)) return;
+
+	uint8_t lane = row - 1;
+	for (uint8_t i = lanes.laneStart[lane]; i < lanes.laneStart[lane + 1]; i++) {
+		int16_t x = lanes.xpos[i];
+		int16_t entityWidth = SPRITE_IMAGES[lanes.sprite[i]].width;
+
+		if (lane < WATER_ROWS) {
+			//positions covered by this log move with it
+			uint32_t on[LEVEL_WORDS] = {0};
+			setRange(on, x + LEVEL_MARGIN, x + entityWidth - width - LEVEL_MARGIN);
+			for (uint8_t w = 0; w < LEVEL_WORDS; w++) on[w] &= bits[w];
+			shiftInto(carried, on, x - oldX[i]);
+		} else {
+			//positions overlapping this car are lost
+			if (i == lanes.laneStart[lane]) setRange(safe, LEFT_BORDER, RIGHT_BORDER - width);
+			clearRange(safe, x - width - LEVEL_MARGIN, x + entityWidth + LEVEL_MARGIN);
+		}
+	}
+
+	for (uint8_t w = 0; w < LEVEL_WORDS; w++) {
+		bits[w] = lane < WATER_ROWS ? carried[w] : bits[w] & safe[w];
+	}
+}
+
+/* Starts a search of a level: a player may start in any column of the bottom row */
+static void searchBegin(const struct Level *level) {
+	uint8_t offset = xOffset(SPRITE_FROG_UP);
+
+	levelFill(&lanes, level);
+	current = 0;
+	searched = 0;
+	memset(&reach[current], 0, sizeof(reach[current]));
+	addSnapped(reach[current].ready[SHAPE_UP][GRID_HEIGHT - 1], (1 << GRID_WIDTH) - 1, 0, offset);
+}
+
+/* Runs a search on for some ticks
+ * Returns:
+ * 	-the crossing time [ticks], LEVEL_UNSOLVABLE, or LEVEL_SEARCHING if the search is not over
+ */
+static uint16_t searchRun(const struct Prng *rng, uint16_t ticks) {
+	uint8_t oldX[MAX_ENTITIES];
+	uint8_t vertical[GRID_HEIGHT], left[GRID_HEIGHT], right[GRID_HEIGHT];
+	uint8_t upOffset = xOffset(SPRITE_FROG_UP), sideOffset = xOffset(SPRITE_FROG_RIGHT);
+
+	while (ticks-- > 0) {
+		struct Reach *now = &reach[current], *next = &reach[current ^ 1];
+		bool alive = false;
+
+		if (searched == LEVEL_SEARCH_TICKS) return LEVEL_UNSOLVABLE;
+		searched++;
+		memcpy(oldX, lanes.xpos, lanes.count);
+		entitiesAt(&lanes, rng, searched);
+		memset(next, 0, sizeof(*next));
+
+		//columns hops start from: any column for up and down, and for sideways hops the ones
+		//isValidMove() lets through, checked from the unsnapped position of each shape
+		for (uint8_t row = 0; row < GRID_HEIGHT; row++) {
+			vertical[row] = left[row] = right[row] = 0;
+			for (uint8_t shape = 0; shape < LEVEL_SHAPES; shape++) {
+				uint8_t width = SPRITE_IMAGES[SHAPE_SPRITES[shape]].width;
+				const uint32_t *bits = now->ready[shape][row];
+
+				vertical[row] |= columns(bits, LEFT_BORDER, RIGHT_BORDER);
+				left[row] |= columns(bits, LEFT_BORDER + GRID_SIZE, RIGHT_BORDER);
+				right[row] |= columns(bits, LEFT_BORDER, RIGHT_BORDER - width - GRID_SIZE);
+			}
+		}
+
+		for (uint8_t row = 0; row < GRID_HEIGHT; row++) {
+			//stay put (a player that just hopped returns to center)
+			for (uint8_t shape = 0; shape < LEVEL_SHAPES; shape++) {
+				for (uint8_t w = 0; w < LEVEL_WORDS; w++) next->ready[shape][row][w] = now->ready[shape][row][w] | now->landed[shape][row][w];
+			}
+
+			//hop in from the row below or above, facing up or down (hops leave the two top water rows unsnapped)
+			for (int8_t from = row - 1; from <= row + 1; from += 2) {
+				if (from < 0 || from >= GRID_HEIGHT) continue;
+				if (from >= WATER_ROWS) {
+					addSnapped(next->landed[SHAPE_UP][row], vertical[from], 0, upOffset);
+				} else {
+					for (uint8_t w = 0; w < LEVEL_WORDS; w++) {
+						next->landed[SHAPE_UP][row][w] |= now->ready[SHAPE_UP][from][w] | now->ready[SHAPE_SIDE][from][w];
+					}
+				}
+			}
+
+			//hop in sideways, facing sideways
+			addSnapped(next->landed[SHAPE_SIDE][row], left[row], -1, sideOffset);
+			addSnapped(next->landed[SHAPE_SIDE][row], right[row], 1, sideOffset);
+
+			for (uint8_t shape = 0; shape < LEVEL_SHAPES; shape++) {
+				uint8_t width = SPRITE_IMAGES[SHAPE_SPRITES[shape]].width;
+				settle(next->ready[shape][row], row, oldX, width);
+				settle(next->landed[shape][row], row, oldX, width);
+				alive |= anyBits(next->ready[shape][row]) || anyBits(next->landed[shape][row]);
+			}
+		}
+
+		current ^= 1;
+		for (uint8_t shape = 0; shape < LEVEL_SHAPES; shape++) {
+			if (anyBits(next->ready[shape][0]) || anyBits(next->landed[shape][0])) return searched;
+		}
+		if (!alive) return LEVEL_UNSOLVABLE;
+	}
+	return LEVEL_SEARCHING;
+}
+
+/* Draws one layout for a difficulty */
+static void draw(struct Level *level, struct Prng *rng, uint8_t difficulty) {
+	const struct Difficulty *settings = &DIFFICULTIES[difficulty];
+
+	level->difficulty = difficulty;
+	for (uint8_t lane = 0; lane < ENTITY_ROWS; lane++) {
+		struct LanePattern *pattern = &level->lanes[lane];
+		bool water = lane < WATER_ROWS;
+
+		memset(pattern, 0, sizeof(*pattern));
+		pattern->count = water ? LOGS_PER_ROW : settings->minCars + prngBelow(rng, settings->maxCars - settings->minCars + 1);
+		pattern->direction = prngBelow(rng, 2) ? PS2_RIGHT : PS2_LEFT;
+		pattern->speed = water ? randSpeed(rng, settings->logMin, settings->logMax) : randSpeed(rng, settings->carMin, settings->carMax);
+
+		//each entity gets an equal share of the lane and starts somewhere in it, leaving a car's width to spare
+		uint8_t share = (GAME_WIDTH - 2) / pattern->count;
+		for (uint8_t j = 0; j < pattern->count; j++) {
+			uint8_t sprite = water ? SPRITE_LOG : prngBelow(rng, NUM_CAR_SPRITES);
+			uint8_t width = SPRITE_IMAGES[sprite].width;
+			uint8_t slack = pattern->count == 1 ? share - width : share - 2 * width;
+
+			pattern->sprite[j] = sprite;
+			pattern->xpos[j] = LEFT_BORDER + 1 + j * share + prngBelow(rng, slack + 1);
+		}
+	}
+	//the search and the game draw the logs' bounce speeds from the generator as it is after the layout
+	level->rng = *rng;
+}
+
+/***************************************************
+ * Functions
+ **************************************************/
+
+void levelBegin(struct LevelGen *gen, uint32_t seed, uint8_t difficulty) {
+	prngSeed(&gen->rng, seed);
+	gen->difficulty = difficulty;
+	gen->tries = 0;
+	gen->drawn = 0;
+	gen->spent = 0;
+	gen->searching = false;
+	gen->done = false;
+} //end levelBegin()
+
+bool levelStep(struct LevelGen *gen) {
+	if (gen->done) return true;
+
+	//out of tries for this difficulty: try an easier one, or give up after the easiest
+	if (!gen->searching && gen->tries == LEVEL_TRIES) {
+		if (gen->difficulty == 0) {
+			gen->level = LEVEL_FALLBACK;
+			gen->done = true;
+			return true;
+		}
+		gen->difficulty--;
+		gen->tries = 0;
+	}
+
+	//draw a layout, and search it over the next steps
+	if (!gen->searching) {
+		draw(&gen->level, &gen->rng, gen->difficulty);
+		gen->tries++;
+		gen->drawn++;
+		searchBegin(&gen->level);
+		gen->searching = true;
+		return false;
+	}
+
+	uint16_t crossing = searchRun(&gen->level.rng, LEVEL_STEP_TICKS);
+	gen->spent += LEVEL_STEP_TICKS;
+	if (crossing == LEVEL_SEARCHING) {
+		if (gen->spent >= LEVEL_BUDGET_TICKS) {
+			gen->level = LEVEL_FALLBACK;
+			gen->done = true;
+		}
+		return gen->done;
+	}
+
+	gen->searching = false;
+	if (crossing != LEVEL_UNSOLVABLE && crossing >= DIFFICULTIES[gen->difficulty].minCrossing) {
+		gen->level.crossing = crossing;
+		gen->done = true;
+	} else if (gen->spent >= LEVEL_BUDGET_TICKS) {
+		gen->level = LEVEL_FALLBACK;
+		gen->done = true;
+	}
+	return gen->done;
+} //end levelStep()
+
+uint8_t levelGenerate(struct Level *level, uint32_t seed, uint8_t difficulty) {
+	struct LevelGen gen;
+
+	levelBegin(&gen, seed, difficulty);
+	while (!levelStep(&gen));
+	*level = gen.level;
+	return gen.drawn;
+} //end levelGenerate()
+
+void levelFill(struct EntityStore *store, const struct Level *level) {
+	store->count = 0;
+	for (uint8_t lane = 0; lane < ENTITY_ROWS; lane++) {
+		const struct LanePattern *pattern = &level->lanes[lane];
+
+		store->laneStart[lane] = store->count;
+		for (uint8_t j = 0; j < pattern->count; j++) {
+			uint8_t i = store->count++;
+			store->xpos[i] = pattern->xpos[j];
+			store->xfrac[i] = 0;
+			store->origin[i] = pattern->xpos[j] << FIXED_SHIFT;
+			store->since[i] = 0;
+			store->ypos[i] = (lane + 1) * GRID_SIZE + TOP_BORDER + yOffset(pattern->sprite[j]);
+			store->speed[i] = pattern->speed;
+			store->direction[i] = pattern->direction;
+			store->lane[i] = lane;
+			store->sprite[i] = pattern->sprite[j];
+		}
+	}
+	store->laneStart[ENTITY_ROWS] = store->count;
+} //end levelFill()
+
+uint16_t levelSearch(const struct Level *level) {
+	searchBegin(level);
+	return searchRun(&level->rng, LEVEL_SEARCH_TICKS + 1);
+} //end levelSearch()
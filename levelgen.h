@@ -0,0 +1,101 @@
+//**************************************************
+//
+// Authors: Caleb Reiter, Alex Fanner, Chris Chu, Kao Yang
+// Description: Lane layouts for a difficulty, checked to be crossable
+//
+//**************************************************
+
+#ifndef __LEVELGEN_H__
+#define __LEVELGEN_H__
+
+#include "ece210_api.h"
+#include "entities.h"
+#include "prng.h"
+
+#define LEVEL_DIFFICULTIES 4				//difficulties a level can be made for [0, LEVEL_DIFFICULTIES)
+#define LEVEL_TRIES 8								//layouts drawn for a difficulty before an easier one is tried
+#define LEVEL_SEARCH_TICKS 1500			//longest crossing the search looks for [ticks]
+#define LEVEL_BUDGET_TICKS 6000			//search ticks spent on one level before the fallback level is taken [ticks]
+#define LEVEL_STEP_TICKS 4					//search ticks one step of the generator runs [ticks]
+#define LEVEL_UNSOLVABLE 0xFFFF			//crossing of a layout no player can cross within LEVEL_SEARCH_TICKS
+#define LEVEL_SEARCHING 0						//the search has not found a crossing yet, nor ruled one out
+
+//one lane of a level; every entity in a lane moves the same way
+struct LanePattern {
+	uint8_t count;														//number of entities in the lane [1, MAX_ENTITIES_PER_ROW]
+	uint8_t direction;												//direction of the lane [one of PS2_RIGHT, PS2_LEFT]
+	uint16_t speed;														//speed of the lane, Q8.8 fixed point [1/256 pixels per tick]
+	uint8_t sprite[MAX_ENTITIES_PER_ROW];			//sprite id of each entity
+	uint8_t xpos[MAX_ENTITIES_PER_ROW];				//starting x position of each entity, left to right [pixels]
+};
+
+//every lane of a level, as it starts
+struct Level {
+	uint8_t difficulty;												//difficulty the level was made for
+	uint16_t crossing;												//fewest ticks a player needs from the bottom row to the top [ticks]
+	struct Prng rng;													//random number generator the logs' bounce speeds follow from
+	struct LanePattern lanes[ENTITY_ROWS];		//every lane, top water row first
+};
+
+//a level being generated a few search ticks at a time (the search itself is kept in levelgen.c,
+//so one level is generated at a time)
+struct LevelGen {
+	struct Prng rng;													//random number generator the layouts are drawn from
+	struct Level level;												//the layout being searched, and the level once done
+	uint8_t difficulty;												//difficulty the layouts are drawn for
+	uint8_t tries;														//layouts drawn for that difficulty
+	uint8_t drawn;														//layouts drawn in all
+	uint16_t spent;														//search ticks run in all [ticks]
+	bool searching;														//if a layout is being searched
+	bool done;																//if the level is finished
+};
+
+//level taken when no layout drawn is crossable in time; the search crosses it (frogger_levels checks it)
+extern const struct Level LEVEL_FALLBACK;
+
+/* Starts generating a level: layouts are drawn until one can be crossed and is not too easy for the
+ * difficulty; after LEVEL_TRIES layouts the next easier difficulty is tried, and once the easiest runs
+ * out of tries or LEVEL_BUDGET_TICKS search ticks are spent, LEVEL_FALLBACK is taken
+ * Parameters:
+ * 	-*gen: the generator
+ * 	-seed: the seed the layouts follow from
+ * 	-difficulty: the difficulty aimed for [0, LEVEL_DIFFICULTIES)
+ */
+void levelBegin(struct LevelGen *gen, uint32_t seed, uint8_t difficulty);
+
+/* Draws a layout or runs LEVEL_STEP_TICKS ticks of its search
+ * Parameters:
+ * 	-*gen: the generator
+ * Returns:
+ * 	-True once gen->level is finished
+ * 	-False otherwise
+ */
+bool levelStep(struct LevelGen *gen);
+
+/* Generates a level in one go (levelBegin(), then levelStep() until done)
+ * Parameters:
+ * 	-*level: filled with the level
+ * 	-seed: the seed the layouts follow from
+ * 	-difficulty: the difficulty aimed for [0, LEVEL_DIFFICULTIES)
+ * Returns:
+ * 	-the number of layouts drawn
+ */
+uint8_t levelGenerate(struct Level *level, uint32_t seed, uint8_t difficulty);
+
+/* Fills an entity store with a level's entities as they start
+ * Parameters:
+ * 	-*store: the store to fill
+ * 	-*level: the level
+ */
+void levelFill(struct EntityStore *store, const struct Level *level);
+
+/* Finds the fewest ticks in which a player starting anywhere on the bottom row can reach the top row,
+ * over the lanes as they will move
+ * Parameters:
+ * 	-*level: the level (with the generator its logs' bounce speeds follow from)
+ * Returns:
+ * 	-the crossing time [ticks], or LEVEL_UNSOLVABLE
+ */
+uint16_t levelSearch(const struct Level *level);
+
+#endif
@@ -0,0 +1,160 @@
+//**************************************************
+//
+// Authors: Caleb Reiter, Alex Fanner, Chris Chu, Kao Yang
+// Description: Lockstep input exchange between the boards
+//
+// Every board runs the same game (see game.c) and only broadcasts its own
+// player's inputs. An input read on tick t is applied on tick t +
+// LOCKSTEP_DELAY, which gives it that long to reach the other boards; a tick
+// simulated before every input has arrived runs on a guess and is simulated
+// again if the guess was wrong (see rollback.c). Inputs are kept for
+// LOCKSTEP_WINDOW ticks so the ones another board reports missing can be sent
+// again: a board asks when a run arrives past the inputs it knows, and every
+// LOCKSTEP_RESEND_MS while lost inputs hold its game back. The player whose
+// inputs were lost sends them again. When the same inputs are asked for twice,
+// the board asking may not hear their owner well, so a third board (if there
+// is one) relays them as well: the lowest player that neither owns nor lost
+// them. No board runs more than LOCKSTEP_DELAY + ROLLBACK_MAX ticks ahead of
+// another, so a remote input is never more than 2 * (LOCKSTEP_DELAY +
+// ROLLBACK_MAX) ticks ahead of the oldest tick that may still be simulated
+// again and never overwrites one still needed.
+//
+//**************************************************
+
+#include "lockstep.h"
+
+#define SLOT(tick) ((tick) & (LOCKSTEP_WINDOW - 1))
+
+/***************************************************
+ * Helper Functions
+ **************************************************/
+
+/* Builds the message carrying the longest run of equal inputs of a player from a tick on, up to an end */
+static uint8_t run(const struct Lockstep *lockstep, uint8_t player, uint32_t from, uint32_t end, struct Message *message) {
+	const uint8_t *inputs = lockstep->inputs[player];
+	uint8_t count = 1;
+
+	//extend the run while the input stays the same
+	while (from + count < end && count < PROTOCOL_MAX_RUN && inputs[SLOT(from + count)] == inputs[SLOT(from)]) {
+		count++;
+	}
+
+	message->type = MSG_INPUT;
+	message->player = player;
+	message->tick = from & PROTOCOL_TICK_MASK;
+	message->count = count;
+	message->input = inputs[SLOT(from)];
+	return count;
+}
+
+/***************************************************
+ * Functions
+ **************************************************/
+
+void lockstepReset(struct Lockstep *lockstep, uint8_t local, uint8_t numPlayers) {
+	lockstep->local = local;
+	lockstep->numPlayers = numPlayers;
+	lockstep->sent = LOCKSTEP_DELAY;
+	lockstep->relayFrom = lockstep->relayEnd = 0;
+	for (uint8_t player = 0; player < numPlayers; player++) {
+		lockstep->known[player] = LOCKSTEP_DELAY;
+		lockstep->asked[player] = 0;
+		for (uint8_t tick = 0; tick < LOCKSTEP_DELAY; tick++) {
+			lockstep->inputs[player][tick] = PS2_CENTER;
+		}
+	}
+} //end lockstepReset()
+
+void lockstepSample(struct Lockstep *lockstep, uint8_t input) {
+	uint32_t *known = &lockstep->known[lockstep->local];
+	lockstep->inputs[lockstep->local][SLOT(*known)] = input;
+	(*known)++;
+} //end lockstepSample()
+
+bool lockstepReady(const struct Lockstep *lockstep, uint32_t tick) {
+	for (uint8_t player = 0; player < lockstep->numPlayers; player++) {
+		if (lockstep->known[player] <= tick) return false;
+	}
+	return true;
+} //end lockstepReady()
+
+bool lockstepInputs(const struct Lockstep *lockstep, uint32_t tick, uint8_t inputs[GAME_MAX_PLAYERS]) {
+	bool known = true;
+	for (uint8_t player = 0; player < lockstep->numPlayers; player++) {
+		if (lockstep->known[player] > tick) {
+			inputs[player] = lockstep->inputs[player][SLOT(tick)];
+		} else {
+			inputs[player] = lockstep->inputs[player][SLOT(lockstep->known[player] - 1)];
+			known = false;
+		}
+	}
+	return known;
+} //end lockstepInputs()
+
+uint8_t lockstepLagging(const struct Lockstep *lockstep) {
+	uint8_t lagging = 0;
+	for (uint8_t player = 1; player < lockstep->numPlayers; player++) {
+		if ((int32_t)(lockstep->known[player] - lockstep->known[lagging]) < 0) lagging = player;
+	}
+	return lagging;
+} //end lockstepLagging()
+
+bool lockstepPending(const struct Lockstep *lockstep) {
+	return lockstep->relayFrom != lockstep->relayEnd || lockstep->sent < lockstep->known[lockstep->local];
+} //end lockstepPending()
+
+void lockstepMessage(struct Lockstep *lockstep, struct Message *message) {
+	if (lockstep->relayFrom != lockstep->relayEnd) {
+		lockstep->relayFrom += run(lockstep, lockstep->relayPlayer, lockstep->relayFrom, lockstep->relayEnd, message);
+	} else {
+		lockstep->sent += run(lockstep, lockstep->local, lockstep->sent, lockstep->known[lockstep->local], message);
+	}
+} //end lockstepMessage()
+
+bool lockstepReceive(struct Lockstep *lockstep, const struct Message *message) {
+	if (message->player >= lockstep->numPlayers || message->player == lockstep->local) return false;
+
+	uint32_t *known = &lockstep->known[message->player];
+	uint32_t first = protocolTick(message->tick, *known);
+	uint32_t end = first + message->count;
+
+	//a run starting past the inputs known means one was lost
+	if ((int32_t)(first - *known) > 0) return true;
+	//nothing new
+	if ((int32_t)(end - *known) <= 0) return false;
+
+	for (; *known != end; (*known)++) {
+		lockstep->inputs[message->player][SLOT(*known)] = message->input;
+	}
+	return false;
+} //end lockstepReceive()
+
+void lockstepResend(struct Lockstep *lockstep, const struct Message *message) {
+	uint8_t player = message->player;
+	if (player >= lockstep->numPlayers) return;
+
+	if (player == lockstep->local) {
+		uint32_t from = protocolTick(message->tick, lockstep->sent);
+
+		//only inputs still kept can be sent again
+		if ((int32_t)(from - lockstep->sent) < 0 && (int32_t)(lockstep->known[player] - from) <= LOCKSTEP_WINDOW) {
+			lockstep->sent = from;
+		}
+		return;
+	}
+
+	//only inputs asked for a second time are relayed, by the lowest player that neither lost them nor owns them
+	uint32_t from = protocolTick(message->tick, lockstep->known[player]);
+	bool again = from == lockstep->asked[player];
+	uint8_t relay = 0;
+	lockstep->asked[player] = from;
+	while (relay == player || relay == message->sender) relay++;
+	if (!again || relay != lockstep->local || lockstep->relayFrom != lockstep->relayEnd) return;
+
+	//relay the inputs this board has from the tick asked for on
+	if ((int32_t)(lockstep->known[player] - from) > 0 && (int32_t)(lockstep->known[player] - from) <= LOCKSTEP_WINDOW) {
+		lockstep->relayPlayer = player;
+		lockstep->relayFrom = from;
+		lockstep->relayEnd = lockstep->known[player];
+	}
+} //end lockstepResend()
@@ -0,0 +1,103 @@
+//**************************************************
+//
+// Authors: Caleb Reiter, Alex Fanner, Chris Chu, Kao Yang
+// Description: Lockstep input exchange between the boards
+//
+//**************************************************
+
+#ifndef __LOCKSTEP_H__
+#define __LOCKSTEP_H__
+
+#include "ece210_api.h"
+#include "game.h"
+#include "protocol.h"
+
+#define LOCKSTEP_DELAY 2						//ticks between reading an input and the tick it is applied on, covering part of the radio's latency [ticks]
+#define LOCKSTEP_WINDOW 64					//inputs kept per player, more than 2 * (LOCKSTEP_DELAY + ROLLBACK_MAX) (power of two) [ticks]
+#define LOCKSTEP_RESEND_MS 200			//time the game may be held back before the missing inputs are asked for again [ms]
+#define LOCKSTEP_TIMEOUT_MS 3000		//time without the other players' inputs after which the game is abandoned [ms]
+
+//every player's input over the ticks around the one being simulated
+struct Lockstep {
+	uint8_t local;																	//index of the local player
+	uint8_t numPlayers;															//number of players in the game
+	uint32_t known[GAME_MAX_PLAYERS];								//each player's inputs are known for every tick before this one [ticks]
+	uint32_t sent;																	//the local inputs are sent for every tick before this one [ticks]
+	uint32_t asked[GAME_MAX_PLAYERS];								//tick each player's inputs were last asked for from [ticks]
+	uint8_t relayPlayer;														//player whose inputs are sent on its behalf (if relayFrom != relayEnd)
+	uint32_t relayFrom;															//first tick of that player's inputs still to be relayed [ticks]
+	uint32_t relayEnd;															//the inputs are relayed up to this tick [ticks]
+	uint8_t inputs[GAME_MAX_PLAYERS][LOCKSTEP_WINDOW];	//each player's input by tick (index tick % LOCKSTEP_WINDOW)
+};
+
+/* Starts a game: every player's input over the first LOCKSTEP_DELAY ticks is PS2_CENTER
+ * Parameters:
+ * 	-*lockstep: the lockstep state
+ * 	-local: index of the local player
+ * 	-numPlayers: number of players in the game
+ */
+void lockstepReset(struct Lockstep *lockstep, uint8_t local, uint8_t numPlayers);
+
+/* Records the local player's input; call once per tick simulated, it applies LOCKSTEP_DELAY ticks later
+ * Parameters:
+ * 	-*lockstep: the lockstep state
+ * 	-input: the input read [one of PS2_CENTER, PS2_RIGHT, PS2_UP, PS2_LEFT, PS2_DOWN]
+ */
+void lockstepSample(struct Lockstep *lockstep, uint8_t input);
+
+/* Checks whether every player's input is known for a tick
+ * Parameters:
+ * 	-*lockstep: the lockstep state
+ * 	-tick: the tick to be simulated [ticks]
+ * Returns:
+ * 	-True if the tick can be simulated
+ * 	-False if an input has not arrived yet
+ */
+bool lockstepReady(const struct Lockstep *lockstep, uint32_t tick);
+
+/* Copies every player's input for a tick; a player whose input has not arrived yet is guessed
+ * to keep its last known input
+ * Parameters:
+ * 	-*lockstep: the lockstep state
+ * 	-tick: the tick to be simulated [ticks]
+ * 	-inputs: filled with each player's input
+ * Returns:
+ * 	-True if every input is known
+ * 	-False if any was guessed
+ */
+bool lockstepInputs(const struct Lockstep *lockstep, uint32_t tick, uint8_t inputs[GAME_MAX_PLAYERS]);
+
+/* Returns the index of the player whose inputs are known for the fewest ticks (the one holding the game back) */
+uint8_t lockstepLagging(const struct Lockstep *lockstep);
+
+/* Returns true if there are inputs to send: local inputs not sent yet or another player's to relay */
+bool lockstepPending(const struct Lockstep *lockstep);
+
+/* Builds the message carrying the longest run of equal inputs waiting to be sent (relayed inputs
+ * first) and counts them as sent
+ * Parameters:
+ * 	-*lockstep: the lockstep state
+ * 	-*message: filled with a MSG_INPUT message
+ */
+void lockstepMessage(struct Lockstep *lockstep, struct Message *message);
+
+/* Takes in a player's inputs from the radio
+ * Parameters:
+ * 	-*lockstep: the lockstep state
+ * 	-*message: a MSG_INPUT message
+ * Returns:
+ * 	-True if earlier inputs of that player are missing and must be asked for again from known[player] on
+ * 	-False otherwise
+ */
+bool lockstepReceive(struct Lockstep *lockstep, const struct Message *message);
+
+/* Answers a board that lost inputs: the local player's are sent again, and another player's are
+ * relayed when they are asked for twice from the same tick and this board is the one chosen to
+ * relay for the board asking
+ * Parameters:
+ * 	-*lockstep: the lockstep state
+ * 	-*message: a MSG_RESEND message
+ */
+void lockstepResend(struct Lockstep *lockstep, const struct Message *message);
+
+#endif
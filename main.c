@@ -5,73 +5,63 @@
 //
 //**************************************************
 
-#include <stdlib.h>
-
 #include "ece210_api.h"
-#include "lab_buttons.h"
 #include "Images.h"
-
-/***************************************************
- * Structures
- **************************************************/
-
-//structure for each entity's image
-struct Image {
-	uint8_t width;								//width of the image [pixels]
-	uint8_t height;								//height of the image [pixels]
-	uint16_t foregroundColor;			//foreground color of the image
-	uint16_t backgroundColor;			//background color of the image
-	const uint8_t *bitmap;				//pointer to bitmap representing the image
-};
-
-//structure for each entity (both players and non-players)
-struct Entity {
-		bool isPlayer;							//if the entity is the player
-		uint8_t xpos;								//x position of entity [pixels]
-		uint16_t ypos;							//y position of entity [pixels]
-		uint8_t move;								//move speed of entity [pixels]
-		uint8_t direction;					//default direction of entity [one of PS2_RIGHT, PS2_UP, PS2_LEFT, PS2_DOWN]
-		struct Image image;					//entity's image
-};
+#include "layout.h"
+#include "background.h"
+#include "game.h"
+#include "render.h"
+#include "clock.h"
+#include "protocol.h"
+#include "lockstep.h"
+#include "rollback.h"
+#include "session.h"
+#include "netqueue.h"
+#include "tasks.h"
+#include "leds.h"
+#include "input.h"
+#include "profile.h"
+#include "replay.h"
+
+#ifdef HOST_SIM
+#include "ece210_sim.h"
+#else
+#define simFrameEnd()
+#define simFrameStop()
+#define simRollbackBegin()
+#define simRollbackEnd(ticks)
+#endif
 
 /***************************************************
  * Function Prototypes
  **************************************************/
 
-/* Updates an entity's position based on its current direction
- * Parameters:
- * 	-*entity: pointer to the entity to be updated
- */
-void updateEntity(struct Entity *entity);
-
-/* Updates player's position based on joystick and button input
- * Parameters:
- * -*player: pointer to the player's entity
- * -*canMove: pointer to the canMove variable
+/* Reads the local player's input for one tick: the joystick's direction, or the direction of a button pressed since the last tick
+ * Returns:
+ * 	-the direction of the input [one of PS2_CENTER, PS2_RIGHT, PS2_UP, PS2_LEFT, PS2_DOWN]
  */
-void updatePlayer(struct Entity *player, bool *canMove);
+uint8_t readInput(void);
 
-/* Determines whether a move is valid based on entity's current position and planned move
- * Parameters:
- * 	-entity: the entity whose move is being validated (no pointer necessary because no entity variables are being modified)
- * 	-direction: the direction the entity is planning on moving
+/* Waits for the player to press a button or move the joystick, running the tasks meanwhile
  * Returns:
- * 	-True if the entity is not the player or if the entity is a player and can move in the indicated direction
+ * 	-True if the player chose up
  * 	-False otherwise
  */
-bool isValidMove(struct Entity entity, uint8_t direction);
+bool waitChoice(void);
 
-/* Renders an entity on the screen
+/* Places every entity in the renderer (entity i in render slot i)
  * Parameters:
- * 	-entity: the entity to be rendered (no pointer necessary because no entity variables are being modified)
+ * 	-*store: the entities to render
  */
-void render(struct Entity entity);
+void renderEntities(const struct EntityStore *store);
 
-/* Erases an entity's image from the screen
+/* Places a player in the renderer; it is drawn on the next renderFlush()
  * Parameters:
- * 	-: entity: the entity to be erased
+ * 	-slot: the player's render slot (players in higher slots are drawn on top)
+ * 	-*player: the player to be rendered
+ * 	-sprite: the sprite id to draw the player with (centered where the player's own image is)
  */
-void erase(struct Entity entity);
+void renderPlayer(uint8_t slot, const struct Player *player, uint8_t sprite);
 
 /* Prints a string in red on the center of the screen (for debugging purposes)
  * Parameters:
@@ -82,174 +72,90 @@ void print(char *string, uint8_t row);
 /* Clears the screen of any messages or images */
 void clearScreen(void);
 
-/* Initialize entity array with random entities
- * Parameters:
- * 	-a: the height of the array
- * 	-b: the width of the array
- * 	-entities[][]: array of entities to initialize
- */
-void fillEntities(uint8_t a, uint8_t b, struct Entity entities[a][b]);
-
-/* Initialize a single entity with the given variables
- * Parameters:
- * 	-*entity: the entity to initialize (pointer because variables are being modified)
- * 	-isPlayer: if the entity is a player
- * 	-xpos: x position of the entity [pixels]
- * 	-ypos: y position of the entity [pixels]
- * 	-move: move speed of the entity [pixels]
- * 	-direction: direction of the entity [one of PS2_RIGHT, PS2_UP, PS2_LEFT, PS2_DOWN]
- * 	-image: the entity's image
- */
-void initEntity(struct Entity *entity, bool isPlayer, uint8_t xpos, uint16_t ypos, uint8_t move, uint8_t direction, struct Image image);
-
-/* Generate a random image from the list of entity images
+/* Takes in every message that has arrived and sends what the radio budget allows (always scheduled)
  * Returns:
- * 	-the random image
+ * 	-the time until the radio is polled again [ms]
  */
-struct Image randImage(void);
+uint32_t radioTask(void);
 
-/* Determines whether a number is in a given range (inclusive)
- * Parameters:
- * 	-num: the number to compare
- * 	-start: the start of the range
- * 	-end: the end of the range
+/* Joins the lobby when the local player presses up, forgets players that left and repeats the ready message
  * Returns:
- * 	-True if the number is within the given range (inclusive)
- * 	-False otherwise
+ * 	-the time until the lobby is checked again [ms]
  */
- bool inRange(uint8_t num, uint8_t start, uint8_t end);
+uint32_t lobbyTask(void);
 
-/* Generate a random number in the given range (inclusive-exclusive)
- * Parameters:
- * 	-start: start of the range
- * 	-end: end of the range
+/* Counts down to the start of the game, one number per step
  * Returns:
- * 	-a random number in the range
+ * 	-the time until the next number [ms], or TASK_DONE once the game begins
  */
-uint8_t randRange(uint8_t start, uint8_t end);
+uint32_t countdownTask(void);
 
-/* Calculate the x offset to render the entity in the horizontal center of each grid location
- * Parameters:
- * 	-image: the image being offset
+/* Generates the game's level a few search ticks per step, while the countdown runs
  * Returns:
- * 	-the x offset of the image [pixels]
+ * 	-0 to take the next step right away, or TASK_DONE once the level is finished
  */
-uint8_t xOffset(struct Image image);
+uint32_t levelTask(void);
 
-/* Calculate the y offset to render the entity in the vertical center of each grid location
- * Parameters:
- * 	-image: the image being offset
+/* Corrects wrong guesses, runs every simulation tick that is due and draws the frame
  * Returns:
- * 	-the y offset of the image [pixels]
- */
-uint8_t yOffset(struct Image image);
-
-/* Draw water for each water row */
-void drawWater(void);
-
-/* Draw grass for the top and bottom rows */
-void drawGrass(void);
-
-/* Draw borders around the edge of the game */
-void drawBorders(void);
-
-/* Set all LEDs along the top of the board to the given color
- * Parameters:
- * 	-red: red value of the color to set
- * 	-green: green value of the color to set
- * 	-blue: blue value of the color to set
+ * 	-the time until the next tick is due [ms], or TASK_DONE once the game is over or the connection is lost
  */
-void setTopLEDs(uint8_t red, uint8_t green, uint8_t blue);
+uint32_t playTask(void);
 
-/* Corrects the x and y offset of an entity based on its image
+/* Draws a new share of the game's seed from the time spent waiting for the players and the joystick's noise
  * Parameters:
- * 	-*entity: the entity to correct
- */
-void correctOffset(struct Entity *entity);
-
-/* Compares two images to determine whether they are equal (deep comparison)
- * Parameters:
- * 	-image1: the first image to compare
- * 	-image2: the second image to compare
+ * 	-ticks: number of passes of the ready loop so far
  * Returns:
- * 	-True if the images are exactly the same
- * 	-False otherwise
- */
-bool compareImage(struct Image image1, struct Image image2);
-
-/* Corrects an entity's background image based on its current position
- * Parameters:
- * 	-*entity: the entity to correct
+ * 	-the share
  */
-void correctBackgroundImage(struct Entity *entity);
+uint16_t drawShare(uint32_t ticks);
 
 /***************************************************
  * Global Constants and Variables
  **************************************************/
 
-#define LCD_WIDTH 240			//LCD width [pixels]
-#define LCD_HEIGHT 320		//LCD height [pixels]
-
-/* Possible positions of the player are represented as a GRID_WIDTH by GRID_HEIGHT grid; each move
- * brings the player from one grid location to another, and the player will never be in more
- * than one grid location at any given time
- */
-#define GRID_SIZE	30			//height/width of each grid location [pixels]
-#define GRID_WIDTH 7			//width of grid [number of grid locations]
-#define GRID_HEIGHT	10		//height of grid [number of grid locations]
-
-#define RED_ON 0x08				//color corresponding to RED
-#define GREEN_ON 0x08			//color corresponding to GREEN
-#define BLUE_ON 0x04			//color corresponding to BLUE
 #define ALL_ON 0xFF				//color corresponding to all LEDs on
 
-#define TOP_BORDER (LCD_HEIGHT - GRID_HEIGHT * GRID_SIZE) / 2		//position of top border [pixels]
-#define LEFT_BORDER (LCD_WIDTH - GRID_WIDTH * GRID_SIZE) / 2		//position of left border [pixels]
-#define RIGHT_BORDER LEFT_BORDER + GRID_WIDTH * GRID_SIZE				//position of right border [pixels]
-#define BOTTOM_BORDER TOP_BORDER + GRID_HEIGHT * GRID_SIZE			//position of bottom border [pixels]
-
-#define GAME_WIDTH RIGHT_BORDER - LEFT_BORDER				//width of game screen [pixels]
-#define GAME_HEIGHT TOP_BORDER - BOTTOM_BORDER			//height of game screen [pixels]
-
-#define WATER_ROWS 3														//number of rows of logs [number of rows]
-#define CAR_ROWS GRID_HEIGHT - WATER_ROWS - 2		//number of rows of cars [number of rows]
-#define ENTITY_ROWS WATER_ROWS + CAR_ROWS				//number of rows containing entities (excludes top and bottom rows) [number of rows]
-
-#define LOGS_PER_ROW 1							//number of logs per water row [number of logs]
-#define CARS_PER_ROW 1							//number of cars per car row [number of cars]
-#define MAX_ENTITIES_PER_ROW 3  		//maximum number of non-player entities per row [number of entities]
-
-#define LOG_MIN_MOVE 1					//minimum move speed of logs [pixels]
-#define LOG_MAX_MOVE 2					//maximum move speed of logs [pixels]
-#define CAR_MIN_MOVE 1					//minimum move speed of cars [pixels]
-#define CAR_MAX_MOVE 2					//maximum move speed of cars [pixels]
-
-#define NUM_ENTITY_IMAGES 3			//number of different non-player images [number of images]
-
-#define LOCAL_ID 0x11 			//ID of local board
-#define REMOTE_ID 0x00			//ID of remote board
-
-#define UP_BUTTON 0x01			//data corresponding to up button being pressed
-#define WIN 0x00FF00FF			//data corresponding to a player winning
-
-//constant array containing all possible non-player entity images
-const struct Image ENTITY_IMAGES[] = {
-	{CAR1_BITMAP_WIDTH, CAR1_BITMAP_HEIGHT, CAR1_FOREGROUND_COLOR, CAR1_BACKGROUND_COLOR, CAR1_BITMAP},										//car1 image
-	{RACECAR_BITMAP_WIDTH, RACECAR_BITMAP_HEIGHT, RACECAR_FOREGROUND_COLOR, RACECAR_BACKGROUND_COLOR, RACECAR_BITMAP},		//racecar image
-	{TRUCK_BITMAP_WIDTH, TRUCK_BITMAP_HEIGHT, TRUCK_FOREGROUND_COLOR, TRUCK_BACKGROUND_COLOR, TRUCK_BITMAP}								//truck image
-};
-
-//constant image for all logs
-const struct Image LOG_IMAGE = {LOG_BITMAP_WIDTH, LOG_BITMAP_HEIGHT, LOG_FOREGROUND_COLOR, LOG_BACKGROUND_COLOR, LOG_BITMAP};
-
-//frog images for each direction
-const struct Image FROG_IMAGE_UP = {FROG_BITMAP_UP_WIDTH, FROG_BITMAP_UP_HEIGHT, FROG_FOREGROUND_COLOR, FROG_BACKGROUND_COLOR, FROG_BITMAP_UP};
-const struct Image FROG_IMAGE_RIGHT = {FROG_BITMAP_RIGHT_WIDTH, FROG_BITMAP_RIGHT_HEIGHT, FROG_FOREGROUND_COLOR, FROG_BACKGROUND_COLOR, FROG_BITMAP_RIGHT};
-const struct Image FROG_IMAGE_LEFT = {FROG_BITMAP_LEFT_WIDTH, FROG_BITMAP_LEFT_HEIGHT, FROG_FOREGROUND_COLOR, FROG_BACKGROUND_COLOR, FROG_BITMAP_LEFT};
-const struct Image FROG_IMAGE_DOWN = {FROG_BITMAP_DOWN_WIDTH, FROG_BITMAP_DOWN_HEIGHT, FROG_FOREGROUND_COLOR, FROG_BACKGROUND_COLOR, FROG_BITMAP_DOWN};
-
-//player 2 image
-const struct Image FROG2_IMAGE = {FROG_BITMAP_UP_WIDTH, FROG_BITMAP_UP_HEIGHT, FROG2_FOREGROUND_COLOR, FROG2_BACKGROUND_COLOR, FROG_BITMAP_UP};
+#define PLAYERS_SLOT MAX_ENTITIES										//first render slot of the other players (after every entity's slot)
+#define FROG_SLOT (PLAYERS_SLOT + GAME_MAX_PLAYERS - 1)		//render slot of the local player (drawn on top)
+
+#define SESSION_ADDRESS 0x11 	//radio address every board of a session sends to and listens on
+
+#define TICK_MS 12					//length of one simulation tick [ms]
+#define MAX_TICKS_PER_FRAME 4	//ticks run before a frame is drawn anyway; further missed ticks are dropped [ticks]
+#define DIFFICULTY 1				//difficulty of the lanes [0, LEVEL_DIFFICULTIES)
+#define RADIO_POLL_MS 1			//time between two polls of the radio, well under the time the receive FIFO takes to fill [ms]
+#define LOBBY_POLL_MS 1			//time between two checks of the lobby [ms]
+#define COUNTDOWN_MS 1000		//time each number of the countdown is shown [ms]
+#define FLASH_MS 25					//time the LEDs stay on and off when flashing an invalid move [ms]
+#define FLASHES 2						//flashes shown for an invalid move
+#define RAINBOW_LEVEL 50		//brightest level of the winner's rainbow
+#define RAINBOW_MS 125			//time the winner's rainbow takes to move one LED along [ms]
+#define RAINBOWS 2					//times the winner's rainbow goes all the way along the LEDs
+#define BLINK_MS 150				//time the LEDs stay on and off when the game is lost [ms]
+#define BLINKS 5						//blinks shown when the game is lost
+
+#define PHASE_LOBBY 0				//the radio carries ready messages
+#define PHASE_GAME 1				//the radio carries inputs (from the countdown until the next lobby)
+
+//state shared by the tasks (kept out of the stack: the rollback snapshots take over a kilobyte)
+static struct Session session;			//the players in the lobby
+static struct Game game;						//the game every board simulates
+static struct Lockstep lockstep;		//every player's inputs to the game
+static struct Rollback rollback;		//snapshots for correcting wrong guesses
+static struct LevelGen generator;		//the level being generated for the game
+static struct NetQueue queue;				//messages waiting to be transmitted wirelessly
+static struct ProtocolLink link;		//sequence state of the radio link
+static uint8_t phase;								//what the radio carries (PHASE_*)
+static uint8_t local;								//index of the local player
+static bool connected;							//if the other players' inputs kept arriving
+static uint32_t ticks = 0;					//number of passes of the lobby so far - used to seed random number generator
+static uint8_t shownPlayers;				//number of ready players last displayed
+static uint32_t readySentMs;				//time the ready message was last queued [ms]
+static uint32_t nextTick;						//time the next simulation tick is due [ms]
+static uint32_t lastTickMs;					//time a tick was last simulated [ms]
+static uint32_t resendMs;						//time inputs holding the game back were last asked for [ms]
+static uint8_t countdownStep;				//steps the countdown has taken
 
 /**************************************************
  * Main
@@ -261,202 +167,96 @@ int main(void) {
 	ece210_lcd_add_msg("2-Player Frogger", TERMINAL_ALIGN_CENTER, LCD_COLOR_GREEN);
 	for (uint8_t i = 0; i < 6; i++) { ece210_lcd_add_msg("", TERMINAL_ALIGN_CENTER, LCD_COLOR_BLACK); }
 	ece210_lcd_add_msg("Initializing...", TERMINAL_ALIGN_CENTER, LCD_COLOR_CYAN);
-	ece210_wireless_init(LOCAL_ID, REMOTE_ID);
+	ece210_wireless_init(SESSION_ADDRESS, SESSION_ADDRESS);
+	backgroundInit();
+	clockInit();
+	inputReset();
+	taskStart(inputTask, 0);
 	
 	//display ID message
-	char idmsg[20];
-	sprintf(idmsg, "LOCAL ID: %d, REMOTE ID: %d", LOCAL_ID, REMOTE_ID); 
+	char idmsg[32];
+	sprintf(idmsg, "SESSION ADDRESS: %d", SESSION_ADDRESS);
 	ece210_lcd_add_msg(idmsg, TERMINAL_ALIGN_CENTER, LCD_COLOR_BLUE2);
 	
 	//set initial conditions
 	bool playing = true;					//if the player is still playing the game
-	bool alive = true;						//if the player is still alive (hasn't lost)
 	bool localWin = false;				//if the local player has won
-	bool remoteWin = false;				//if the remote player has won
-	bool canMove = true;					//if the player is able to move (cannot move after moving until joystick is returned to center)
-	bool localReady = false;			//if the local player is ready to play
-	bool remoteReady = false;			//if the remote player is ready to play
-	uint32_t ticks = 0;						//number of ticks until game starts - used to seed random number generator
-	uint32_t data;								//data being transmitted wirelessly
-	uint32_t player2data;					//data being received wirelessly
-	uint16_t oldx, oldy;					//old x and y position of the frog
-	
-	//array of all entities to be updated
-	struct Entity entities[ENTITY_ROWS][MAX_ENTITIES_PER_ROW] = {0, 0, 0, 0, 0, 0};
-	
-	//initialize frog entity
-	struct Entity frog;
-	frog.isPlayer = true;
-	frog.move = GRID_SIZE;
-	frog.image = FROG_IMAGE_UP;
-	
-	//initialize player 2 entity
-	struct Entity frog2;
-	frog2.image = FROG2_IMAGE;
+	int8_t winner = -1;						//index of the player that won, or -1
+	char msg[32];									//message being displayed
 	
 	//overall game loop (spans multiple games)
 	while(playing) {
 	
 		//initialize wireless
-		ece210_wireless_init(LOCAL_ID, REMOTE_ID);
-		//reset ready status of both players
-		localReady = false;
-		remoteReady = false;
+		ece210_wireless_init(SESSION_ADDRESS, SESSION_ADDRESS);
+		protocolReset(&link, 0);
+		netqueueReset(&queue, NULL);
+		phase = PHASE_LOBBY;
+		//empty the lobby
+		sessionReset(&session);
+		shownPlayers = 0;
 		
 		//prompt to ready up
 		ece210_lcd_add_msg("Press up key to play.", TERMINAL_ALIGN_CENTER, LCD_COLOR_BLUE);
-		//loop while both players are not ready
-		while (!localReady || !remoteReady) {
-			//wait for local player to be ready
-			if (btn_up_pressed() && !localReady) {
-				//set local player status to ready
-				localReady = true;
-				//send ready status to player 2
-				ece210_wireless_send(UP_BUTTON);
-				//display local ready message
-				ece210_lcd_add_msg("You are ready!", TERMINAL_ALIGN_CENTER, LCD_COLOR_GREEN);
-			}
-			
-			//wait for player 2 to be ready
-			if (ece210_wireless_data_avaiable() && !remoteReady) {
-				//if up button is received
-				if (ece210_wireless_get() == UP_BUTTON) {
-					//set player 2 status to ready
-					remoteReady = true;
-					//display player 2 ready message
-					ece210_lcd_add_msg("Opponent is ready!", TERMINAL_ALIGN_CENTER, LCD_COLOR_RED);
-				}
-			}
-			
-			//increment ticks
-			ticks++;
-		}
+		//run the lobby until every player in it is ready and agrees on who is playing
+		taskStart(radioTask, 0);
+		taskStart(lobbyTask, 0);
+		while (!sessionReady(&session)) tasksRun();
+		taskStop(lobbyTask);
+		
+		//make sure the other players have the last ready message too
+		netqueueFlush(&queue, &link, true);
 			
-		//seed random number generator
-		srand(ticks);
+		//players are numbered by share, and the seed is every share in player order
+		local = sessionLocal(&session);
+		lockstepReset(&lockstep, local, session.numPlayers);
+		recordStart(sessionSeed(&session), session.numPlayers, DIFFICULTY);
+		protocolReset(&link, local);
+		netqueueReset(&queue, &lockstep);
+		//inputs of players that begin first are taken in during the countdown
+		phase = PHASE_GAME;
 			
 		//start game
 		ece210_lcd_add_msg("All players are ready.", TERMINAL_ALIGN_CENTER, LCD_COLOR_WHITE);
 		ece210_lcd_add_msg("Starting in:", TERMINAL_ALIGN_CENTER, LCD_COLOR_WHITE);
-		ece210_lcd_add_msg("3", TERMINAL_ALIGN_CENTER, LCD_COLOR_RED);
-		setTopLEDs(100, 0, 0);
-		ece210_wait_mSec(1000);
-	
-		ece210_lcd_add_msg("2", TERMINAL_ALIGN_CENTER, LCD_COLOR_ORANGE);
-		setTopLEDs(100, 100, 0);
-		ece210_wait_mSec(1000);
-	
-		ece210_lcd_add_msg("1", TERMINAL_ALIGN_CENTER, LCD_COLOR_YELLOW);
-		setTopLEDs(0, 100, 0);
-		ece210_wait_mSec(1000);
-	
-		ece210_lcd_add_msg("Begin!", TERMINAL_ALIGN_CENTER, LCD_COLOR_GREEN);
-		setTopLEDs(0, 0, 0);
+		//the level is generated while the countdown runs, a step at a time so the radio keeps being polled
+		levelBegin(&generator, sessionSeed(&session), DIFFICULTY);
+		taskStart(levelTask, 0);
+		taskStart(countdownTask, 0);
+		while (taskActive(countdownTask) || taskActive(levelTask)) tasksRun();
+		gameStart(&game, sessionSeed(&session), session.numPlayers, &generator.level);
+		rollbackReset(&rollback, &game);
 		
-		//reset game conditions
-		alive = true;
-		localWin = false;
-		remoteWin = false;
-		frog.xpos = LEFT_BORDER + randRange(0, GRID_WIDTH) * GRID_SIZE + xOffset(frog.image);
-		frog.ypos = TOP_BORDER + ((GRID_HEIGHT - 1) * GRID_SIZE) + yOffset(frog.image);
-		frog2.xpos = LEFT_BORDER + randRange(0, GRID_WIDTH) * GRID_SIZE + xOffset(frog2.image);
-		frog2.ypos = TOP_BORDER + ((GRID_HEIGHT - 1) * GRID_SIZE) + yOffset(frog2.image);
-		fillEntities(ENTITY_ROWS, MAX_ENTITIES_PER_ROW, entities);
+		//reset game conditions (presses made before the game began do not count)
+		inputFlush();
+		profileReset();
+		connected = true;
+		winner = -1;
 		clearScreen();
-		drawBorders();
-		drawWater();
-		drawGrass();
+		renderReset();
 		
-		//individual game loop (runs for one game)
-		while(alive && !localWin && !remoteWin) {
-			
-			//temporary variables to hold old frog position
-			oldx = frog.xpos;
-			oldy = frog.ypos;
-			
-			//update and render non-player entities
-			for (uint8_t i = 0; i < ENTITY_ROWS; i++) {
-				for (uint8_t j = 0; j < (i < WATER_ROWS ? LOGS_PER_ROW : CARS_PER_ROW); j++) {
-					updateEntity(&entities[i][j]);
-					render(entities[i][j]);
-				}
-			}
-			
-			//update player's position
-			updatePlayer(&frog, &canMove);
-			
-			//calculate frog's current row, leftmost position, and rightmost position
-			uint8_t row = (frog.ypos - TOP_BORDER) / GRID_SIZE;
-			uint8_t f_left = frog.xpos;
-			uint8_t f_right = frog.xpos + frog.image.width;	
-			
-			//only check for collisions if the player is not on the first or last row
-			if (row != GRID_HEIGHT - 1 && row != 0) {
-				//if the player is not in a water row
-				if (row > WATER_ROWS) {
-					//check for collisions between player and non-player entities on same row
-					for (uint8_t i = 0; i < CARS_PER_ROW; i++) {
-						uint8_t e_left = entities[row - 1][i].xpos;
-						uint8_t e_right = entities[row - 1][i].xpos + entities[row - 1][i].image.width;		
-						if (inRange(e_left, f_left, f_right) || inRange(e_right, f_left, f_right)) {
-							alive = false;
-						}
-					}
-				} else {
-					//determine whether player is on a log
-					bool onLog = false;
-					for (uint8_t i = 0; i < LOGS_PER_ROW; i++) {
-						uint8_t e_left = entities[row - 1][i].xpos;
-						uint8_t e_right = entities[row - 1][i].xpos + entities[row - 1][i].image.width;
-						if (f_left >= e_left && f_left <= e_right && f_right >= e_left && f_right <= e_right) {
-							onLog = true;
-							frog.xpos += entities[row - 1][i].move * (entities[row - 1][i].direction == PS2_LEFT ? -1 : 1);
-						}
-					}
-					if (!onLog) alive = false;
-				}
-			}
-			
-			//send new position if it has changed from old position
-			if (frog.xpos != oldx || frog.ypos != oldy) {
-				//note: next if statement is necessary to prevent sending too many updates in a small period of time;
-				//implementing a delay (e.g. only sending every 3rd update) still did not fix the issue of player 2 not
-				//being rendered when on the water rows, so the condition is left to prevent freezing
-				if (row > WATER_ROWS) {
-					data = (frog.xpos << 16) + frog.ypos;
-					ece210_wireless_send(data);
-				}
-			}
-			
-			//clear player 2's image
-			erase(frog2);
-			
-			//update player 2's position if new data is available
-			if (ece210_wireless_data_avaiable()) {
-				player2data = ece210_wireless_get();
-				if (player2data != WIN) {
-					frog2.xpos = (player2data & 0xFFFF0000) >> 16;
-					frog2.ypos = player2data & 0x0000FFFF;
-					correctBackgroundImage(&frog2);
-				} else {
-					remoteWin = true;
-				}
-			}
-			
-			//correct offset for player 2's image
-			correctOffset(&frog2);
-			
-			//render players
-			render(frog2);
-			render(frog);
-			
-			//check for a winner
-			if (frog.ypos < TOP_BORDER + GRID_SIZE) {
-				localWin = true;
-				ece210_wireless_send(WIN);
-			}
-
-		} // end while (alive && !localWin && !remoteWin)
+		//play until the game is over for every player or the connection is lost
+		nextTick = clockMs();
+		lastTickMs = nextTick;
+		resendMs = nextTick;
+		taskStart(playTask, 0);
+		while (taskActive(playTask)) tasksRun();
+		simFrameStop();
+		ledsStop();
+		profileDump();
+		
+		//send every input still queued, which the other players need to reach the same end
+		//(the radio keeps answering their requests for lost inputs until the next lobby)
+		netqueueFlush(&queue, &link, true);
+		
+		//the game ends for every player when one has won or all have died, as of the last tick
+		//whose inputs are all known (the ticks after it ran on guesses)
+		const struct Game *final = rollbackConfirmed(&rollback, &game);
+		recordEnd(&lockstep, final);
+		localWin = final->players[local].status == PLAYER_WON;
+		for (uint8_t i = 0; i < final->numPlayers; i++) {
+			if (final->players[i].status == PLAYER_WON) winner = i;
+		}
 		
 		//display endgame messages
 		if (localWin) {
@@ -465,40 +265,23 @@ int main(void) {
 			ece210_lcd_add_msg("YOU WIN!", TERMINAL_ALIGN_CENTER, LCD_COLOR_YELLOW);
 			
 			//display rainbow on LEDs
-			for(uint8_t i = 0; i < 5; i++){
-				setTopLEDs(RED_ON, GREEN_ON, BLUE_ON);
-				ece210_ws2812b_write( 0, 50, GREEN_ON, BLUE_ON);
-				ece210_wait_mSec(150);
-				ece210_ws2812b_write( 1, RED_ON, 50, BLUE_ON);
-				ece210_wait_mSec(150);
-				ece210_ws2812b_write( 2, RED_ON, GREEN_ON, 50);
-				ece210_wait_mSec (150);
-				ece210_ws2812b_write( 3, 25, 50, 120);
-				ece210_wait_mSec (150);
-				ece210_ws2812b_write( 4, RED_ON, 100, 50);
-				ece210_wait_mSec (150);
-				ece210_ws2812b_write( 5, 50, 50, BLUE_ON);
-				ece210_wait_mSec (150);
-				ece210_ws2812b_write( 6, 50, GREEN_ON, 50);
-				ece210_wait_mSec (150); 
-				ece210_ws2812b_write( 7, RED_ON, 50, 50);
-				ece210_wait_mSec (150); 
-			}
+			ledsRainbow(RAINBOW_LEVEL, RAINBOW_MS, RAINBOWS);
+			while (ledsBusy()) tasksRun();
 		
 		} else {
 			//display game over message
-			if (remoteWin) {
-				ece210_lcd_add_msg("PLAYER 2 WINS!", TERMINAL_ALIGN_CENTER, LCD_COLOR_RED);
+			if (!connected) {
+				ece210_lcd_add_msg("CONNECTION LOST!", TERMINAL_ALIGN_CENTER, LCD_COLOR_ORANGE);
+			} else if (winner >= 0) {
+				sprintf(msg, "PLAYER %d WINS!", winner + 1);
+				ece210_lcd_add_msg(msg, TERMINAL_ALIGN_CENTER, LCD_COLOR_RED);
 			} else {
 				ece210_lcd_add_msg("GAME OVER!", TERMINAL_ALIGN_CENTER, LCD_COLOR_ORANGE);
 			}
 			
 			//display red LEDs
-			for (uint8_t i = 0; i < 10; i++) {	
-				setTopLEDs(100, 0, 0);
-				ece210_wait_mSec (150);
-				setTopLEDs(0, 0, 0);
-			}
+			ledsBlink(100, 0, 0, BLINK_MS, BLINK_MS, BLINKS);
+			while (ledsBusy()) tasksRun();
 			
 		}
 		
@@ -507,180 +290,254 @@ int main(void) {
 		ece210_lcd_add_msg("Press any other button to quit.", TERMINAL_ALIGN_CENTER, LCD_COLOR_WHITE);
 		
 		//clear LEDs
-		setTopLEDs(0, 0, 0);
+		ledsFill(0, 0, 0);
 		
-		//wait until a button is pressed
-		while(!btn_right_pressed() && !btn_up_pressed() && !btn_left_pressed() && !btn_down_pressed()
-					&& ece210_ps2_read_position() == PS2_CENTER) {
-		}
-		
-		//if any button is pressed other than the up button, stop playing the game
-		if (!btn_up_pressed() && ece210_ps2_read_position() != PS2_UP) {
-			playing = false;
-		}
+		//wait until a button is pressed; if any button is pressed other than the up button, stop playing the game
+		playing = waitChoice();
 		
 	} // end while(playing)
 	
 	//final message
+	taskStop(radioTask);
 	ece210_lcd_add_msg("", TERMINAL_ALIGN_CENTER, LCD_COLOR_BLACK);
 	ece210_lcd_add_msg("THANKS FOR PLAYING!", TERMINAL_ALIGN_CENTER, LCD_COLOR_WHITE);
 	clearScreen();
 	
+	return 0;
 } // end main
 
 /***************************************************
- * Functions
+ * Tasks
  **************************************************/
 
-void updateEntity(struct Entity *entity) {
-	//only move if the entity's move is valid (only applies to player)
-	if (isValidMove(*entity, entity->direction)) {
-		
-		//erase entity's image from its current spot
-		erase(*entity);
+uint32_t radioTask(void) {
+	struct Message message;				//message received, or sent in reply
+	PROFILE_BEGIN(PROFILE_RADIO);
+	
+	//take in every message that has arrived
+	while (ece210_wireless_data_avaiable()) {
+		uint32_t word = ece210_wireless_get();
+		uint8_t type = protocolReceive(&link, word, &message);
+		if (phase == PHASE_GAME) recordRadio(word);
 		
-		//change player image to indicate direction
-		if (entity->isPlayer) {
-			switch(entity->direction) {
-				case PS2_RIGHT:
-					entity->image = FROG_IMAGE_RIGHT; break;
-				case PS2_UP:
-					entity->image = FROG_IMAGE_UP; break;
-				case PS2_LEFT:
-					entity->image = FROG_IMAGE_LEFT; break;
-				case PS2_DOWN:
-					entity->image = FROG_IMAGE_DOWN; break;
+		if (phase == PHASE_LOBBY) {
+			if (type == MSG_READY && sessionReceive(&session, &message)) {
+				//another player drew the same share: both draw again
+				while (!sessionJoin(&session, drawShare(ticks))) ticks++;
+				readySentMs = clockMs() - SESSION_REPEAT_MS;
 			}
-			
-			//correct offset for new image if not in the water or if moving left/right
-			if (entity->ypos >= TOP_BORDER + GRID_SIZE * WATER_ROWS
-					|| entity->direction == PS2_RIGHT
-					|| entity->direction == PS2_LEFT) {
-						correctOffset(entity);
+		} else if (type == MSG_INPUT) {
+			//ask again for inputs lost on the way
+			if (lockstepReceive(&lockstep, &message)) {
+				message.type = MSG_RESEND;
+				message.tick = lockstep.known[message.player] & PROTOCOL_TICK_MASK;
+				netqueueSignal(&queue, &message);
 			}
+		} else if (type == MSG_RESEND) {
+			lockstepResend(&lockstep, &message);
 		}
-		
-		//move entity based on current direction
-		switch(entity->direction) {
-			case PS2_RIGHT:
-				entity->xpos += entity->move; break;
-			case PS2_UP:
-				entity->ypos -= entity->move; break;
-			case PS2_LEFT:
-				entity->xpos -= entity->move; break;
-			case PS2_DOWN:
-				entity->ypos += entity->move;	break;
+	}
+	
+	//send what the radio budget allows
+	netqueueFlush(&queue, &link, false);
+	PROFILE_END(PROFILE_RADIO);
+	return RADIO_POLL_MS;
+} //end radioTask()
+
+uint32_t lobbyTask(void) {
+	struct Message message;				//ready message sent
+	char msg[32];									//message being displayed
+	
+	//wait for local player to be ready; joining fails while the lobby is full or the share drawn is
+	//taken, and is tried again on the next step for as long as the button is held
+	if ((inputButtons() & INPUT_UP) && !session.joined && sessionJoin(&session, drawShare(ticks))) {
+		//send the ready message right away
+		readySentMs = clockMs() - SESSION_REPEAT_MS;
+		//display local ready message
+		ece210_lcd_add_msg("You are ready!", TERMINAL_ALIGN_CENTER, LCD_COLOR_GREEN);
+	}
+	
+	//forget the players that left
+	sessionUpdate(&session);
+	
+	//display the number of players ready whenever it changes
+	if (session.numPlayers != shownPlayers) {
+		if (session.numPlayers > 0) {
+			sprintf(msg, "Players ready: %d", session.numPlayers);
+			ece210_lcd_add_msg(msg, TERMINAL_ALIGN_CENTER, LCD_COLOR_RED);
 		}
+		shownPlayers = session.numPlayers;
+	}
 	
-		//correct entity when going off screen to the right
-		if (entity->direction == PS2_RIGHT && entity->xpos + entity->image.width >= RIGHT_BORDER) {
-			//if entity is a log, switch direction with new random speed
-			if (compareImage(entity->image, LOG_IMAGE)) {
-				entity->xpos = entity->xpos - 1;
-				entity->direction = PS2_LEFT;
-				entity->move = randRange(LOG_MIN_MOVE, LOG_MAX_MOVE + 1);
-			} else {
-				//if entity is not a log, loop entity from right to left
-				entity->xpos = LEFT_BORDER + 1;
-			}
+	//repeat the ready message so players that joined later hear it too
+	if (session.joined && clockMs() - readySentMs >= SESSION_REPEAT_MS) {
+		sessionMessage(&session, &message);
+		netqueueSignal(&queue, &message);
+		readySentMs = clockMs();
+	}
+	
+	//increment ticks
+	ticks++;
+	return LOBBY_POLL_MS;
+} //end lobbyTask()
+
+uint32_t countdownTask(void) {
+	switch (countdownStep++) {
+		case 0:
+			ece210_lcd_add_msg("3", TERMINAL_ALIGN_CENTER, LCD_COLOR_RED);
+			ledsFill(100, 0, 0);
+			return COUNTDOWN_MS;
+		case 1:
+			ece210_lcd_add_msg("2", TERMINAL_ALIGN_CENTER, LCD_COLOR_ORANGE);
+			ledsFill(100, 100, 0);
+			return COUNTDOWN_MS;
+		case 2:
+			ece210_lcd_add_msg("1", TERMINAL_ALIGN_CENTER, LCD_COLOR_YELLOW);
+			ledsFill(0, 100, 0);
+			return COUNTDOWN_MS;
+		default:
+			ece210_lcd_add_msg("Begin!", TERMINAL_ALIGN_CENTER, LCD_COLOR_GREEN);
+			ledsFill(0, 0, 0);
+			countdownStep = 0;
+			return TASK_DONE;
+	}
+} //end countdownTask()
+
+uint32_t levelTask(void) {
+	return levelStep(&generator) ? TASK_DONE : 0;
+} //end levelTask()
+
+uint32_t playTask(void) {
+	struct Message message;				//request for lost inputs
+	
+	//the game ends for every player when one has won or all have died, as of the last tick whose inputs are all known
+	if (gameOver(rollbackConfirmed(&rollback, &game)) || !connected) return TASK_DONE;
+	
+	//simulate again the ticks that guessed another player's input wrong
+	simRollbackBegin();
+	PROFILE_BEGIN(PROFILE_ROLLBACK);
+	uint8_t redone = rollbackCorrect(&rollback, &game, &lockstep);
+	PROFILE_END(PROFILE_ROLLBACK);
+	simRollbackEnd(redone);
+	
+	//run every simulation tick that is due, guessing the other players' inputs that have not arrived; when
+	//drawing falls behind, up to MAX_TICKS_PER_FRAME ticks run between frames and the rest are dropped
+	uint8_t steps = 0;
+	bool waiting = false;
+	while ((int32_t)(clockMs() - nextTick) >= 0) {
+		if (steps == MAX_TICKS_PER_FRAME) {
+			nextTick = clockMs();
+			break;
 		}
-		
-		//correct entity if going off screen to the left
-		if (entity->direction == PS2_LEFT && entity->xpos <= LEFT_BORDER) {
-			//if entity is a log, switch direction with new random speed
-			if (compareImage(entity->image, LOG_IMAGE)) {
-				entity->xpos = entity->xpos + 1;
-				entity->direction = PS2_RIGHT;
-				entity->move = randRange(LOG_MIN_MOVE, LOG_MAX_MOVE + 1);
-			} else {
-				//if entity is not a log, loop entity from left to right
-				entity->xpos = RIGHT_BORDER - entity->image.width - 1;
-			}
+		//wait once too many ticks ran on guesses; the ticks missed while waiting are not made up,
+		//so a board that is ahead of the others falls back behind them instead of stalling every frame
+		if (!rollbackCanStep(&rollback, &game)) {
+			nextTick = clockMs();
+			waiting = true;
+			break;
 		}
+		nextTick += TICK_MS;
+		steps++;
 		
-		//correct background image if the entity is a player
-		if (entity->isPlayer) {
-			correctBackgroundImage(entity);
-		}
+		//read the local input for a later tick, then simulate this one
+		lockstepSample(&lockstep, readInput());
+		PROFILE_BEGIN(PROFILE_TICK);
+		rollbackStep(&rollback, &game, &lockstep);
+		PROFILE_END(PROFILE_TICK);
 		
-	//if entity is a player and entity tries to make an invalid move
-	} else if (entity->isPlayer) {
-		//display flashing lights to indicate invalid move
-		for (uint8_t i = 0; i < 2; i++) {
-			//turn lights on
-			setTopLEDs(100, 100, 0);
-			//pause
-			ece210_wait_mSec (25);
-			//turn lights off
-			setTopLEDs(0, 0, 0);
-		}
+		//display flashing lights to indicate an invalid move
+		if (game.players[local].blocked && !ledsBusy()) ledsBlink(100, 100, 0, FLASH_MS, FLASH_MS, FLASHES);
 	}
-} //end updateEntity()
-
-void updatePlayer(struct Entity *player, bool *canMove) {
 	
-	//read direction of joystick
-	uint8_t direction = ece210_ps2_read_position();
+	//record the ticks every board now agrees on
+	recordTicks(&lockstep, rollbackConfirmed(&rollback, &game));
 	
-	//override direction variable if buttons are being used instead
-	if (AlertButtons) {
-		AlertButtons = false;
-		if (btn_right_pressed()) direction = PS2_RIGHT;
-		if (btn_up_pressed()) direction = PS2_UP;
-		if (btn_left_pressed()) direction = PS2_LEFT;
-		if (btn_down_pressed()) direction = PS2_DOWN;
+	//draw a frame only if the game moved on or was corrected
+	if (steps > 0 || redone > 0) {
+		PROFILE_BEGIN(PROFILE_RENDER);
+		//render the latest state of every entity
+		renderEntities(&game.entities);
+		
+		//render players (the local player on top) and draw everything that changed this frame
+		uint8_t slot = PLAYERS_SLOT;
+		for (uint8_t i = 0; i < game.numPlayers; i++) {
+			if (i != local) renderPlayer(slot++, &game.players[i], SPRITE_FROG2);
+		}
+		renderPlayer(FROG_SLOT, &game.players[local], game.players[local].sprite);
+		renderFlush();
+		PROFILE_END(PROFILE_RENDER);
+		
+		//mark the end of the frame (host simulator only)
+		simFrameEnd();
 	}
 	
-	//if no directional input, reset move variable; else, if the player can move, move player
-	if (direction == PS2_CENTER) {
-		//allow player to move again
-		*canMove = true;
-	} else if (*canMove) {
-		//prevent player from making further moves until no input is detected
-		*canMove = false;
-		//update player's direction variable
-		player->direction = direction;
-		//update player entity
-		updateEntity(player);
+	//give up on a game another player stopped sending inputs to
+	if (steps > 0) {
+		lastTickMs = clockMs();
+	} else if (clockMs() - lastTickMs > LOCKSTEP_TIMEOUT_MS) {
+		connected = false;
 	}
-} //end updatePlayer();
-
-bool isValidMove(struct Entity entity, uint8_t direction) {
+	
+	//the inputs holding the game back may have been lost along with every later one: ask for them again
+	if (waiting && clockMs() - lastTickMs >= LOCKSTEP_RESEND_MS && clockMs() - resendMs >= LOCKSTEP_RESEND_MS) {
+		message.type = MSG_RESEND;
+		message.player = lockstepLagging(&lockstep);
+		message.tick = lockstep.known[message.player] & PROTOCOL_TICK_MASK;
+		netqueueSignal(&queue, &message);
+		resendMs = clockMs();
+	}
+	
+	//step again when the next tick is due (or right after the next radio poll, while waiting for the other players)
+	return waiting ? RADIO_POLL_MS : nextTick - clockMs();
+} //end playTask()
 
-	//return true if the entity is not a player
-	if (!entity.isPlayer) return true;
+/***************************************************
+ * Functions
+ **************************************************/
 
-	//return false if entity's move exceeds boundaries based on the move direction
-	switch(direction) {
-		case PS2_RIGHT:
-			if (entity.xpos + entity.image.width + entity.move > RIGHT_BORDER) return false;
-			break;
-		case PS2_UP:
-			if (entity.ypos - entity.move < TOP_BORDER) return false;
-			break;
-		case PS2_LEFT:
-			if (entity.xpos - entity.move < LEFT_BORDER) return false;
-			break;
-		case PS2_DOWN:
-			if (entity.ypos + entity.image.height + entity.move > BOTTOM_BORDER) return false;
-			break;
+uint8_t readInput(void) {
+	struct InputEvent event;			//button or joystick change
+	
+	//read direction of joystick
+	uint8_t direction = inputJoystick();
+	
+	//override direction variable if buttons are being used instead (the last press since the previous tick wins)
+	while (inputPoll(&event)) {
+		if (event.type != INPUT_PRESS) continue;
+		if (event.value == INPUT_RIGHT) direction = PS2_RIGHT;
+		if (event.value == INPUT_UP) direction = PS2_UP;
+		if (event.value == INPUT_LEFT) direction = PS2_LEFT;
+		if (event.value == INPUT_DOWN) direction = PS2_DOWN;
 	}
 	
-	//return true if the entity is a player and can make the desired move
-	return true;
+	return direction;
+} //end readInput()
+
+bool waitChoice(void) {
+	struct InputEvent event;			//button or joystick change
 	
-} //end isValidMove()
+	//only what the player does from now on counts
+	inputFlush();
+	while (true) {
+		while (inputPoll(&event)) {
+			if (event.type == INPUT_PRESS) return event.value == INPUT_UP;
+			if (event.type == INPUT_JOYSTICK && event.value != PS2_CENTER) return event.value == PS2_UP;
+		}
+		tasksRun();
+	}
+} //end waitChoice()
 
-void render(struct Entity entity) {
-	//draw the entity on the screen
-	ece210_lcd_draw_image(entity.xpos, entity.image.width, entity.ypos, entity.image.height, entity.image.bitmap, 
-												entity.image.foregroundColor, entity.image.backgroundColor);
-} //end render()
+void renderEntities(const struct EntityStore *store) {
+	for (uint8_t i = 0; i < store->count; i++) {
+		renderSprite(i, store->xpos[i], store->ypos[i], &SPRITE_IMAGES[store->sprite[i]]);
+	}
+} //end renderEntities()
 
-void erase(struct Entity entity) {
-	ece210_lcd_draw_image(entity.xpos, entity.image.width, entity.ypos, entity.image.height, entity.image.bitmap,
-												entity.image.backgroundColor, entity.image.backgroundColor);
-} //end erase()
+void renderPlayer(uint8_t slot, const struct Player *player, uint8_t sprite) {
+	//place the player; only the pixels that changed are drawn when the frame is flushed
+	renderSprite(slot, player->xpos - xOffset(player->sprite) + xOffset(sprite),
+							 player->ypos - yOffset(player->sprite) + yOffset(sprite), &SPRITE_IMAGES[sprite]);
+} //end renderPlayer()
 
 void print(char *string, uint8_t row) {
 	//print the string
@@ -696,158 +553,13 @@ void clearScreen() {
 	ece210_lcd_draw_rectangle(0, LCD_WIDTH, 0, LCD_HEIGHT, LCD_COLOR_BLACK);
 } //end clearScreen()
 
-void fillEntities(uint8_t a, uint8_t b, struct Entity entities[a][b]) {
-	
-	//initial variables
-	uint8_t xpos;														//x position of entity being initialized [pixels]
-	uint8_t car_mid = CARS_PER_ROW / 2;			//middle car in the row [number of entities]
-	uint8_t log_mid = LOGS_PER_ROW / 2;			//middle log in the row [number of entities]
-	
-	//loop over each row of entities
-	for (uint8_t i = 0; i < ENTITY_ROWS; i++) {
-		
-		//generate random x position for the middle entity in the row
-		uint8_t xmid = randRange(LEFT_BORDER, RIGHT_BORDER);
-		//generate random direction for all entities in the row
-		uint8_t direction = (randRange(1,100) % 2 == 1 ? PS2_RIGHT : PS2_LEFT);
-		
-		uint8_t spacing;
-		struct Image image;
-		uint8_t move;
-		
-		if (i < WATER_ROWS) {
-			image = LOG_IMAGE; 
-			//calculate spacing based on number of entities in the row and the width of the entities' images
-			spacing = (GAME_WIDTH - (LOGS_PER_ROW * image.width)) / LOGS_PER_ROW;
-			//generate random move speed for all entities in the row
-			move = randRange(LOG_MIN_MOVE, LOG_MAX_MOVE + 1);
-		} else {
-			//generate random image for all entities in the row
-			image = randImage();
-			//calculate spacing based on number of entities in the row and the width of the entities' images
-			spacing = (GAME_WIDTH - (CARS_PER_ROW * image.width)) / CARS_PER_ROW;
-			//generate random move speed for all entities in the row
-			move = randRange(CAR_MIN_MOVE, CAR_MAX_MOVE + 1);
-		}
-		
-		//loop over entities in the row
-		for (uint8_t j = 0; j < (i < WATER_ROWS ? LOGS_PER_ROW : CARS_PER_ROW); j++) {
-			
-			//calculate x position of each entity based on previously generated x position of middle entity
-			xpos = xmid + (j - (i < WATER_ROWS ? log_mid : car_mid)) * (spacing + image.width);
-			
-			//correct x positions if they are off screen either left or right
-			if (xpos < LEFT_BORDER) xpos = RIGHT_BORDER + xpos;
-			if (xpos > RIGHT_BORDER - image.width) xpos = LEFT_BORDER + xpos - (RIGHT_BORDER - image.width);
-						
-			//initialize the entity with all variables
-			initEntity(	&entities[i][j],																			//pointer address
-									false,																								//isPlayer
-									xpos,																									//xpos
-									(i + 1) * GRID_SIZE + TOP_BORDER + yOffset(image),		//ypos
-									move,																									//move
-									direction,																						//direction
-									image);																								//image
-		}
-	}
-	
-} //end fillEntities()
-
-void initEntity(struct Entity *entity, bool isPlayer, uint8_t xpos, uint16_t ypos, uint8_t move, uint8_t direction, struct Image image) {
-	//assign all variables to the given entity
-	entity->isPlayer = isPlayer;
-	entity->xpos = xpos;
-	entity->ypos = ypos;
-	entity->move = move;
-	entity->direction = direction;
-	entity->image = image;
-} //end initEntity()
-
-struct Image randImage() {
-	return ENTITY_IMAGES[randRange(1, 100) % NUM_ENTITY_IMAGES];
-} //end randImage()
-
-bool inRange(uint8_t num, uint8_t start, uint8_t end) {
-	return (num >= start && num <= end);
-} //end inRange()
-
-uint8_t randRange(uint8_t start, uint8_t end) {
-	uint8_t range = end - start;
-	return rand() % range + start;
-} //end randRange()
-								
-uint8_t xOffset(struct Image image) {
-	return (GRID_SIZE - image.width) / 2;
-} //end xOffset()
-
-uint8_t yOffset(struct Image image) {
-	return (GRID_SIZE - image.height) / 2;
-} //end yOffset()
-
-void drawWater() {
-	ece210_lcd_draw_rectangle(LEFT_BORDER + 1, GAME_WIDTH - 2, TOP_BORDER + GRID_SIZE, WATER_ROWS * GRID_SIZE, LCD_COLOR_BLUE);
-} //end drawWater()
-
-void drawGrass() {
-	ece210_lcd_draw_rectangle(LEFT_BORDER + 1, GAME_WIDTH - 2, TOP_BORDER + 1, GRID_SIZE - 1, LCD_COLOR_GREEN2);
-	ece210_lcd_draw_rectangle(LEFT_BORDER + 1, GAME_WIDTH - 2, TOP_BORDER + GRID_SIZE * (GRID_HEIGHT - 1), GRID_SIZE - 1, LCD_COLOR_GREEN2);
-} //end drawGrass()
-
-void drawBorders() {
-	//draw rectangle spanning entire game screen
-	ece210_lcd_draw_rectangle(LEFT_BORDER, GAME_WIDTH, TOP_BORDER, GAME_HEIGHT, LCD_COLOR_GRAY);
-	//clear inside of game screen, leaving a 1 pixel border around the edge
-	ece210_lcd_draw_rectangle(LEFT_BORDER + 1, GAME_WIDTH - 2, TOP_BORDER + 1, GAME_HEIGHT - 2, LCD_COLOR_BLACK);
-} //end drawBorders()
-
-void setTopLEDs(uint8_t red, uint8_t green, uint8_t blue) {
-	for (uint8_t i = 0; i < 8; i++) {
-		ece210_ws2812b_write(i, red, green, blue);
-	}
-}
-
-void correctOffset(struct Entity *entity) {
-	//set position to top left of grid location
-	entity->xpos = ((entity->xpos - LEFT_BORDER) / GRID_SIZE) * GRID_SIZE + LEFT_BORDER;
-	entity->ypos = ((entity->ypos - TOP_BORDER) / GRID_SIZE) * GRID_SIZE + TOP_BORDER;
-	
-	//column the entity is in
-	uint8_t gridx = (entity->xpos - LEFT_BORDER) / GRID_SIZE;
-	//x position of the left side of the column
-	uint8_t leftx = gridx * GRID_SIZE + LEFT_BORDER;
-	//x position of the right side of the column
-	uint8_t rightx = (gridx + 1) * GRID_SIZE + LEFT_BORDER;
-	//if the entity is closer to the right column, set position to right side of column;
-	//else, set position to left side of column
-	if (entity->xpos - leftx > rightx - entity->xpos) {
-		entity->xpos = rightx;
-	} else {
-		entity->xpos = leftx;
-	}
-	//offset position
-	entity->xpos += xOffset(entity->image);
-	entity->ypos += yOffset(entity->image);
-}
-
-bool compareImage(struct Image image1, struct Image image2) {
-	return (image1.backgroundColor == image2.backgroundColor &&
-					image1.bitmap == image2.bitmap &&
-					image1.foregroundColor == image2.foregroundColor &&
-					image1.height == image2.height &&
-					image1.width == image2.width);
-}
-
-void correctBackgroundImage(struct Entity *entity) {
-	//row the entity is in
-	uint8_t row = (entity->ypos - TOP_BORDER) / GRID_SIZE;
-	//if the row is the top or bottom row, set background color to GREEN2;
-	//else, if the row is a water row, set background color to BROWN (logs);
-	//else, set background color to BLACK
-	if (row == 0 || row == GRID_HEIGHT - 1) {
-		entity->image.backgroundColor = LCD_COLOR_GREEN2;
-	} else if (row >= 1 && row <= WATER_ROWS) {
-		entity->image.backgroundColor = LCD_COLOR_BROWN;
-	} else {
-		entity->image.backgroundColor = LCD_COLOR_BLACK;
+uint16_t drawShare(uint32_t ticks) {
+	//the loop count and the time both depend on when the player pressed up, and the low bits of the
+	//resting joystick are noise that differs from board to board even when two players press together;
+	//hashing them makes presses a millisecond apart draw unrelated shares
+	uint16_t noise = 0;
+	for (uint8_t i = 0; i < 4; i++) {
+		noise = (noise << 4) ^ ece210_ps2_read_x() ^ (ece210_ps2_read_y() << 2);
 	}
-}
+	return prngHash(prngHash(ticks) ^ (clockMs() << 16) ^ noise);
+} //end drawShare()
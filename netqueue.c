@@ -0,0 +1,73 @@
+//**************************************************
+//
+// Authors: Caleb Reiter, Alex Fanner, Chris Chu, Kao Yang
+// Description: Rate-limited, coalescing radio send queue
+//
+// The game never calls ece210_wireless_send() from the simulation. It only
+// records the latest message of each type, and the flush after each frame
+// sends at most what a token bucket of NETQUEUE_RATE messages per second
+// (holding up to NETQUEUE_BURST) allows. Inputs are turned into messages only
+// when they are sent, so every tick read since the last message goes out as
+// one run and a slow budget costs latency, never inputs. Every board of a game
+// shares one channel, so once NETQUEUE_CHANNEL_RATE / NETQUEUE_RATE boards
+// play, each board's budget shrinks and its runs grow instead: the airtime of
+// a game stops growing with its number of players. Boards tick together, so
+// their budgets would run out together and every board would send in the same
+// millisecond, overflowing the receive FIFOs; each player's sends are kept in
+// its own slot of the interval instead.
+//
+//**************************************************
+
+#include "netqueue.h"
+
+/***************************************************
+ * Functions
+ **************************************************/
+
+void netqueueReset(struct NetQueue *queue, struct Lockstep *lockstep) {
+	queue->signals = 0;
+	queue->lockstep = lockstep;
+	queue->intervalMs = NETQUEUE_INTERVAL_MS;
+	if (lockstep != NULL && lockstep->numPlayers * 1000 / NETQUEUE_CHANNEL_RATE > NETQUEUE_INTERVAL_MS) {
+		queue->intervalMs = lockstep->numPlayers * 1000 / NETQUEUE_CHANNEL_RATE;
+	}
+	queue->nextSendMs = clockMs() - (NETQUEUE_BURST - 1) * queue->intervalMs;
+	if (lockstep != NULL) queue->nextSendMs += lockstep->local * queue->intervalMs / lockstep->numPlayers;
+} //end netqueueReset()
+
+void netqueueSignal(struct NetQueue *queue, const struct Message *message) {
+	queue->signals |= 1 << message->type;
+	queue->pending[message->type] = *message;
+} //end netqueueSignal()
+
+uint8_t netqueueFlush(struct NetQueue *queue, struct ProtocolLink *link, bool drain) {
+	uint8_t sent = 0;
+	uint32_t now = clockMs();
+
+	//unused budget only builds up to NETQUEUE_BURST messages (skipping whole intervals keeps the board in its slot)
+	int32_t unused = (int32_t)(now - queue->nextSendMs) - (int32_t)((NETQUEUE_BURST - 1) * queue->intervalMs);
+	if (unused > 0) {
+		queue->nextSendMs += (unused + queue->intervalMs - 1) / queue->intervalMs * queue->intervalMs;
+	}
+
+	while (queue->signals || (queue->lockstep != NULL && lockstepPending(queue->lockstep))) {
+		struct Message message;
+
+		if (!drain && (int32_t)(now - queue->nextSendMs) < 0) break;
+
+		if (queue->signals) {
+			//lowest message type first
+			uint8_t type = 0;
+			while (!(queue->signals & (1 << type))) type++;
+			queue->signals &= ~(1 << type);
+			message = queue->pending[type];
+		} else {
+			lockstepMessage(queue->lockstep, &message);
+		}
+
+		ece210_wireless_send(protocolSend(link, &message));
+		queue->nextSendMs += queue->intervalMs;
+		sent++;
+	}
+	return sent;
+} //end netqueueFlush()
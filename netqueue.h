@@ -0,0 +1,55 @@
+//**************************************************
+//
+// Authors: Caleb Reiter, Alex Fanner, Chris Chu, Kao Yang
+// Description: Rate-limited, coalescing radio send queue
+//
+//**************************************************
+
+#ifndef __NETQUEUE_H__
+#define __NETQUEUE_H__
+
+#include "ece210_api.h"
+#include "protocol.h"
+#include "lockstep.h"
+#include "clock.h"
+
+#define NETQUEUE_RATE 25							//radio messages one board sends per second at most [messages/s]
+#define NETQUEUE_CHANNEL_RATE 100			//radio messages every board in a game sends per second together at most [messages/s]
+#define NETQUEUE_BURST 2							//messages that may go out back to back after a quiet period [messages]
+#define NETQUEUE_INTERVAL_MS (1000 / NETQUEUE_RATE)		//time between two messages at the steady rate [ms]
+
+//latest state waiting to be sent, one entry per message type
+struct NetQueue {
+	uint8_t signals;							//pending messages other than inputs, one bit per message type (1 << MSG_*)
+	struct Message pending[MSG_TYPES];		//latest pending message of each type
+	struct Lockstep *lockstep;		//local inputs to send (NULL outside a game)
+	uint32_t intervalMs;					//time between two messages at the steady rate, longer when many boards share the channel [ms]
+	uint32_t nextSendMs;					//time the budget allows the next message [ms]
+};
+
+/* Drops everything pending and restores the full budget; in a game the budget is this board's
+ * share of NETQUEUE_CHANNEL_RATE, up to NETQUEUE_RATE
+ * Parameters:
+ * 	-*queue: the queue to reset
+ * 	-*lockstep: the game's lockstep state whose local inputs are sent (NULL outside a game)
+ */
+void netqueueReset(struct NetQueue *queue, struct Lockstep *lockstep);
+
+/* Queues a message other than inputs (MSG_READY, MSG_RESEND), replacing one of the same type that has not been sent yet
+ * Parameters:
+ * 	-*queue: the queue
+ * 	-*message: the message (copied)
+ */
+void netqueueSignal(struct NetQueue *queue, const struct Message *message);
+
+/* Sends what the budget allows right now (other messages first, then inputs) and returns without waiting
+ * Parameters:
+ * 	-*queue: the queue
+ * 	-*link: the link the messages are sent on
+ * 	-drain: send everything pending regardless of the budget
+ * Returns:
+ * 	-the number of messages sent
+ */
+uint8_t netqueueFlush(struct NetQueue *queue, struct ProtocolLink *link, bool drain);
+
+#endif
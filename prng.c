@@ -0,0 +1,68 @@
+//**************************************************
+//
+// Authors: Caleb Reiter, Alex Fanner, Chris Chu, Kao Yang
+// Description: Portable pseudo-random number generator
+//
+// rand() differs between the Keil and host C libraries and keeps its state
+// hidden, so two boards (or a board and the host simulator) cannot be made to
+// draw the same lanes from it. This generator is counter based: the n-th
+// number of a stream is an integer hash of n spread by a Weyl step and keyed
+// by the stream. Everything is unsigned integer arithmetic, which gives the
+// same bits on the Cortex-M4 and on the host: 32-bit, apart from the 32 x 32
+// to 64-bit multiply of a bounded draw (one UMULL on the Cortex-M4). Jumping
+// ahead is an addition to the counter. Every stream of a seed has its own
+// key, so streams are not shifted copies of one another, but nothing stops
+// two streams from sharing a short run of numbers somewhere. Bounded draws
+// multiply instead of taking a remainder and reject the few values that would
+// make the low results more likely than the high ones.
+//
+//**************************************************
+
+#include "prng.h"
+
+#define PRNG_GOLDEN 0x9E3779B9				//2^32 divided by the golden ratio (spreads counters and stream numbers apart)
+
+/***************************************************
+ * Functions
+ **************************************************/
+
+uint32_t prngHash(uint32_t x) {
+	//lowbias32: a bijection with good avalanche for two multiplies
+	x ^= x >> 16;
+	x *= 0x7FEB352D;
+	x ^= x >> 15;
+	x *= 0x846CA68B;
+	x ^= x >> 16;
+	return x;
+} //end prngHash()
+
+void prngSeed(struct Prng *rng, uint32_t seed) {
+	prngStream(rng, seed, 0);
+} //end prngSeed()
+
+void prngStream(struct Prng *rng, uint32_t seed, uint32_t stream) {
+	rng->key = prngHash(prngHash(seed) + stream * PRNG_GOLDEN);
+	rng->counter = 0;
+} //end prngStream()
+
+uint32_t prngNext(struct Prng *rng) {
+	//the key is mixed in after the counter is spread out, so one stream is never a shifted copy of another
+	return prngHash(rng->counter++ * PRNG_GOLDEN ^ rng->key);
+} //end prngNext()
+
+uint32_t prngBelow(struct Prng *rng, uint32_t bound) {
+	uint64_t scaled = (uint64_t)prngNext(rng) * bound;
+
+	//the low half falls below 2^32 mod bound for the values that would be drawn once too often
+	if ((uint32_t)scaled < bound) {
+		uint32_t threshold = -bound % bound;
+		while ((uint32_t)scaled < threshold) {
+			scaled = (uint64_t)prngNext(rng) * bound;
+		}
+	}
+	return scaled >> 32;
+} //end prngBelow()
+
+void prngJump(struct Prng *rng, uint32_t steps) {
+	rng->counter += steps;
+} //end prngJump()
@@ -0,0 +1,68 @@
+//**************************************************
+//
+// Authors: Caleb Reiter, Alex Fanner, Chris Chu, Kao Yang
+// Description: Portable pseudo-random number generator
+//
+//**************************************************
+
+#ifndef __PRNG_H__
+#define __PRNG_H__
+
+#include <stdint.h>
+
+//generator state; the n-th number of a stream depends only on the stream's key and n, so copying
+//the state snapshots the sequence and copying it back restores it
+struct Prng {
+	uint32_t key;									//the stream drawn from (follows from the seed and stream number)
+	uint32_t counter;							//numbers drawn from the stream so far
+};
+
+/* Starts a sequence from a seed; every board seeded alike draws the same numbers
+ * (the same as stream 0 of the seed)
+ * Parameters:
+ * 	-*rng: the generator
+ * 	-seed: the seed (any value, 0 included)
+ */
+void prngSeed(struct Prng *rng, uint32_t seed);
+
+/* Starts one of many independent sequences of a seed
+ * Parameters:
+ * 	-*rng: the generator
+ * 	-seed: the seed (any value, 0 included)
+ * 	-stream: the sequence's number; different streams of a seed have different keys (unrelated numbers, though not guaranteed never to coincide)
+ */
+void prngStream(struct Prng *rng, uint32_t seed, uint32_t stream);
+
+/* Draws the next number of the sequence
+ * Parameters:
+ * 	-*rng: the generator
+ * Returns:
+ * 	-a pseudo-random 32-bit number
+ */
+uint32_t prngNext(struct Prng *rng);
+
+/* Draws a number below a bound, every value equally likely
+ * Parameters:
+ * 	-*rng: the generator
+ * 	-bound: number of values to draw from (at least 1)
+ * Returns:
+ * 	-a pseudo-random number in [0, bound)
+ */
+uint32_t prngBelow(struct Prng *rng, uint32_t bound);
+
+/* Skips numbers of the sequence without drawing them
+ * Parameters:
+ * 	-*rng: the generator
+ * 	-steps: number of draws to skip
+ */
+void prngJump(struct Prng *rng, uint32_t steps);
+
+/* Scrambles a number so that nearby inputs give unrelated outputs (the generator's mixing function)
+ * Parameters:
+ * 	-x: the number
+ * Returns:
+ * 	-the scrambled number (every input gives a different one)
+ */
+uint32_t prngHash(uint32_t x);
+
+#endif
@@ -0,0 +1,100 @@
+//**************************************************
+//
+// Authors: Caleb Reiter, Alex Fanner, Chris Chu, Kao Yang
+// Description: Per-phase timing of the game loop (built only with PROFILE defined)
+//
+// Phases of the game loop are wrapped in PROFILE_BEGIN/PROFILE_END. On the
+// board they are timed with the Cortex-M4's DWT cycle counter, which costs
+// one register read; on the host simulator, whose virtual clock only charges
+// the HAL, with the host's monotonic clock. Each phase keeps its count,
+// min/avg/max and a histogram with one bucket per power of 2, so a rare slow
+// run shows up next to the typical ones. Phases may nest (a rollback runs
+// ticks, which move the entities), and each is counted on its own. Without
+// PROFILE the markers compile to nothing.
+//
+//**************************************************
+
+#include "profile.h"
+
+#ifdef PROFILE
+
+#ifdef HOST_SIM
+#include <time.h>
+#include "ece210_sim.h"
+#define PROFILE_UNIT "ns"
+#else
+#define PROFILE_UNIT "cycles"
+#endif
+
+/***************************************************
+ * Global Variables
+ **************************************************/
+
+static struct ProfilePhase phases[PROFILE_PHASES];		//timings of every phase
+
+static const char *const names[PROFILE_PHASES] = {
+	"entities", "lanes", "players", "tick", "rollback", "render", "radio", "input", "leds"
+};
+
+/***************************************************
+ * Functions
+ **************************************************/
+
+void profileReset(void) {
+#ifndef HOST_SIM
+	//start the cycle counter (the debug unit must be on for the DWT to count)
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CYCCNT = 0;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+	memset(phases, 0, sizeof(phases));
+} //end profileReset()
+
+uint32_t profileNow(void) {
+#ifdef HOST_SIM
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return now.tv_sec * 1000000000u + now.tv_nsec;
+#else
+	return DWT->CYCCNT;
+#endif
+} //end profileNow()
+
+void profileRecord(uint8_t phase, uint32_t elapsed) {
+	struct ProfilePhase *timing = &phases[phase];
+	uint8_t bucket = 0;
+
+	if (timing->count == 0 || elapsed < timing->min) timing->min = elapsed;
+	if (elapsed > timing->max) timing->max = elapsed;
+	timing->count++;
+	timing->total += elapsed;
+
+	//bucket i holds [2^i, 2^(i+1))
+	while (bucket < PROFILE_BUCKETS - 1 && (elapsed >> (bucket + 1)) != 0) bucket++;
+	timing->buckets[bucket]++;
+} //end profileRecord()
+
+void profileDump(void) {
+#ifdef HOST_SIM
+	printf("board %u: ", simBoard());
+#endif
+	printf("profile [" PROFILE_UNIT "]: phase count min avg max | runs per power of 2\n");
+
+	for (uint8_t phase = 0; phase < PROFILE_PHASES; phase++) {
+		const struct ProfilePhase *timing = &phases[phase];
+		if (timing->count == 0) continue;
+
+#ifdef HOST_SIM
+		printf("board %u: ", simBoard());
+#endif
+		printf("  %-8s %7u %7u %7u %7u |", names[phase], timing->count, timing->min,
+					 (uint32_t)(timing->total / timing->count), timing->max);
+		for (uint8_t bucket = 0; bucket < PROFILE_BUCKETS; bucket++) {
+			if (timing->buckets[bucket] != 0) printf(" 2^%u:%u", bucket, timing->buckets[bucket]);
+		}
+		printf("\n");
+	}
+	fflush(stdout);
+} //end profileDump()
+
+#endif
@@ -0,0 +1,66 @@
+//**************************************************
+//
+// Authors: Caleb Reiter, Alex Fanner, Chris Chu, Kao Yang
+// Description: Per-phase timing of the game loop (built only with PROFILE defined)
+//
+//**************************************************
+
+#ifndef __PROFILE_H__
+#define __PROFILE_H__
+
+#include "ece210_api.h"
+
+#define PROFILE_ENTITIES 0					//moving every entity one tick (entitiesAt)
+#define PROFILE_LANES 1							//sorting the collision lanes (collisionUpdate)
+#define PROFILE_PLAYERS 2						//moving and checking every player one tick
+#define PROFILE_TICK 3							//one simulation tick, snapshot included (rollbackStep)
+#define PROFILE_ROLLBACK 4					//correcting wrong guesses (rollbackCorrect)
+#define PROFILE_RENDER 5						//drawing one frame
+#define PROFILE_RADIO 6							//one poll of the radio (radioTask)
+#define PROFILE_INPUT 7							//one check of the buttons and joystick (inputTask)
+#define PROFILE_LEDS 8							//one step of the LEDs (ledsTask)
+#define PROFILE_PHASES 9						//number of phases timed
+
+#define PROFILE_BUCKETS 24					//histogram buckets, one per power of 2 of the time unit (the last takes everything longer)
+
+#ifdef PROFILE
+
+//timings of one phase
+struct ProfilePhase {
+	uint32_t count;								//times the phase ran
+	uint32_t min;									//shortest run [units]
+	uint32_t max;									//longest run [units]
+	uint64_t total;								//every run together [units]
+	uint32_t buckets[PROFILE_BUCKETS];		//runs that took [2^i, 2^(i+1)) units (bucket 0 also takes 0)
+};
+
+/* Starts the counter and forgets every timing; call before the first phase is timed */
+void profileReset(void);
+
+/* Returns the counter (CPU cycles on the board, nanoseconds on the host simulator) [units] */
+uint32_t profileNow(void);
+
+/* Adds one run of a phase
+ * Parameters:
+ * 	-phase: the phase (PROFILE_*)
+ * 	-elapsed: time the run took [units]
+ */
+void profileRecord(uint8_t phase, uint32_t elapsed);
+
+/* Prints the count, min/avg/max and histogram of every phase that ran (over the debug UART on the board) */
+void profileDump(void);
+
+//time the code between PROFILE_BEGIN(phase) and PROFILE_END(phase) in the same block
+#define PROFILE_BEGIN(phase) uint32_t profileStart##phase = profileNow()
+#define PROFILE_END(phase) profileRecord(phase, profileNow() - profileStart##phase)
+
+#else
+
+#define profileReset()
+#define profileDump()
+#define PROFILE_BEGIN(phase)
+#define PROFILE_END(phase)
+
+#endif
+
+#endif
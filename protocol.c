@@ -0,0 +1,119 @@
+//**************************************************
+//
+// Authors: Caleb Reiter, Alex Fanner, Chris Chu, Kao Yang
+// Description: Radio message format (framed, sequenced, run-length inputs)
+//
+// Every board sends to the same radio address, so every message reaches every
+// board in the session and names its sender. Each sender numbers its messages
+// with a wrapping sequence number so receivers can drop a packet heard twice.
+// Nothing is dropped for being out of order: the 4-bit number cannot tell a
+// late message from one after a long run of losses, and taking an input or a
+// resend request twice, or late, does no harm (lockstep.c). Boards only send
+// inputs (see lockstep.c), and an input stays the same for many ticks in a
+// row, so a message covers a run of up to PROTOCOL_MAX_RUN ticks of one
+// player with one 3-bit input. Ticks are sent as their low bits; the receiver
+// knows roughly which tick it is waiting for and recovers the rest.
+//
+//**************************************************
+
+#include "protocol.h"
+
+#define MSG_TYPE_SHIFT 29
+#define MSG_SENDER_SHIFT 26
+#define MSG_SEQ_SHIFT 22
+#define MSG_PLAYER_SHIFT 19
+#define MSG_PLAYER_MASK 0x07
+#define MSG_TICK_SHIFT 9
+#define MSG_COUNT_SHIFT 3
+#define MSG_COUNT_MASK 0x3F
+#define MSG_INPUT_MASK 0x07
+#define MSG_HEARD_SHIFT 16
+#define MSG_HEARD_MASK 0x0F
+#define MSG_SHARE_MASK 0xFFFF
+
+/***************************************************
+ * Functions
+ **************************************************/
+
+void protocolReset(struct ProtocolLink *link, uint8_t local) {
+	link->local = local;
+	link->txSeq = 0;
+	for (uint8_t sender = 0; sender < PROTOCOL_MAX_PLAYERS; sender++) {
+		link->rxSeq[sender] = 0;
+		link->rxValid[sender] = false;
+	}
+} //end protocolReset()
+
+uint32_t protocolEncode(const struct Message *message) {
+	uint32_t word = ((uint32_t)message->type << MSG_TYPE_SHIFT)
+								| ((uint32_t)(message->sender & MSG_PLAYER_MASK) << MSG_SENDER_SHIFT)
+								| ((uint32_t)(message->seq & PROTOCOL_SEQ_MASK) << MSG_SEQ_SHIFT);
+
+	switch (message->type) {
+		case MSG_READY:
+			word |= ((uint32_t)(message->heard & MSG_HEARD_MASK) << MSG_HEARD_SHIFT) | message->share;
+			break;
+		case MSG_INPUT:
+			word |= ((uint32_t)(message->player & MSG_PLAYER_MASK) << MSG_PLAYER_SHIFT)
+						| ((uint32_t)(message->tick & PROTOCOL_TICK_MASK) << MSG_TICK_SHIFT)
+						| ((uint32_t)(message->count & MSG_COUNT_MASK) << MSG_COUNT_SHIFT) | (message->input & MSG_INPUT_MASK);
+			break;
+		case MSG_RESEND:
+			word |= ((uint32_t)(message->player & MSG_PLAYER_MASK) << MSG_PLAYER_SHIFT) | (message->tick & PROTOCOL_TICK_MASK);
+			break;
+	}
+	return word;
+} //end protocolEncode()
+
+bool protocolDecode(uint32_t word, struct Message *message) {
+	message->type = word >> MSG_TYPE_SHIFT;
+	message->sender = (word >> MSG_SENDER_SHIFT) & MSG_PLAYER_MASK;
+	message->seq = (word >> MSG_SEQ_SHIFT) & PROTOCOL_SEQ_MASK;
+
+	switch (message->type) {
+		case MSG_READY:
+			message->heard = (word >> MSG_HEARD_SHIFT) & MSG_HEARD_MASK;
+			message->share = word & MSG_SHARE_MASK;
+			return true;
+		case MSG_INPUT:
+			message->player = (word >> MSG_PLAYER_SHIFT) & MSG_PLAYER_MASK;
+			message->tick = (word >> MSG_TICK_SHIFT) & PROTOCOL_TICK_MASK;
+			message->count = (word >> MSG_COUNT_SHIFT) & MSG_COUNT_MASK;
+			message->input = word & MSG_INPUT_MASK;
+			return message->count > 0 && message->input <= PS2_RIGHT;
+		case MSG_RESEND:
+			message->player = (word >> MSG_PLAYER_SHIFT) & MSG_PLAYER_MASK;
+			message->tick = word & PROTOCOL_TICK_MASK;
+			return true;
+		default:
+			return false;
+	}
+} //end protocolDecode()
+
+uint32_t protocolSend(struct ProtocolLink *link, struct Message *message) {
+	message->sender = link->local;
+	message->seq = link->txSeq;
+	link->txSeq = (link->txSeq + 1) & PROTOCOL_SEQ_MASK;
+	return protocolEncode(message);
+} //end protocolSend()
+
+uint8_t protocolReceive(struct ProtocolLink *link, uint32_t word, struct Message *message) {
+	if (!protocolDecode(word, message)) return MSG_NONE;
+
+	//boards in the lobby have no player index yet, and their messages say the same thing every time
+	if (message->type == MSG_READY) return MSG_READY;
+
+	//the same number as the last message accepted from this sender is the same packet again
+	if (link->rxValid[message->sender] && message->seq == link->rxSeq[message->sender]) return MSG_NONE;
+
+	link->rxSeq[message->sender] = message->seq;
+	link->rxValid[message->sender] = true;
+	return message->type;
+} //end protocolReceive()
+
+uint32_t protocolTick(uint16_t bits, uint32_t near) {
+	//signed distance from near to the closest tick with these low bits
+	int16_t offset = (bits - near) & PROTOCOL_TICK_MASK;
+	if (offset > PROTOCOL_TICK_MASK / 2) offset -= PROTOCOL_TICK_MASK + 1;
+	return near + offset;
+} //end protocolTick()
@@ -0,0 +1,109 @@
+//**************************************************
+//
+// Authors: Caleb Reiter, Alex Fanner, Chris Chu, Kao Yang
+// Description: Radio message format (framed, sequenced, run-length inputs)
+//
+//**************************************************
+
+#ifndef __PROTOCOL_H__
+#define __PROTOCOL_H__
+
+#include "ece210_api.h"
+
+/* Every radio word is one message, heard by every board in the session:
+ * 	bits 31-29: message type (MSG_*)
+ * 	bits 28-26: sender (index of the sending board's player; 0 in the lobby)
+ * 	bits 25-22: sequence number (wraps, one per message the sender sent)
+ * 	bits 21-0: payload
+ * 		MSG_READY: bits 19-16 number of players the sender has heard in the lobby, bits 15-0 the sender's share of the game's seed
+ * 		MSG_INPUT: bits 21-19 player, bits 18-9 first tick (low bits), bits 8-3 number of ticks, bits 2-0 input
+ * 		MSG_RESEND: bits 21-19 player, bits 9-0 first tick whose inputs are missing (low bits)
+ */
+#define MSG_NONE 0x0								//no message (an empty radio word)
+#define MSG_READY 0x1								//the player is ready to play
+#define MSG_INPUT 0x2								//a player's input over a run of ticks
+#define MSG_RESEND 0x3							//a player's inputs from a tick on were lost, send them again
+#define MSG_TYPES 4									//number of message types
+
+#define PROTOCOL_MAX_PLAYERS 8						//players a message can name [players]
+#define PROTOCOL_SEQ_MASK 0x0F						//mask of a sequence number
+#define PROTOCOL_TICK_MASK 0x03FF					//mask of the tick bits sent in a message
+#define PROTOCOL_MAX_RUN 63								//ticks covered by one MSG_INPUT message [ticks]
+
+//decoded message
+struct Message {
+	uint8_t type;									//message type (MSG_*)
+	uint8_t sender;								//index of the sending board's player
+	uint8_t seq;									//sequence number
+	uint8_t heard;								//number of players the sender has heard in the lobby (MSG_READY)
+	uint16_t share;								//the sender's share of the game's seed (MSG_READY)
+	uint8_t player;								//index of the player the inputs belong to (MSG_INPUT, MSG_RESEND)
+	uint16_t tick;								//first tick, low bits only (MSG_INPUT, MSG_RESEND)
+	uint8_t count;								//number of ticks (MSG_INPUT)
+	uint8_t input;								//input over every one of those ticks (MSG_INPUT)
+};
+
+//sequence state of the radio link to every other board
+struct ProtocolLink {
+	uint8_t local;																//index of the local player (stamped on every message sent)
+	uint8_t txSeq;																//sequence number of the next message sent
+	uint8_t rxSeq[PROTOCOL_MAX_PLAYERS];					//sequence number of the last message accepted from each sender
+	bool rxValid[PROTOCOL_MAX_PLAYERS];						//if any message has been accepted from each sender since the reset
+};
+
+/* Forgets every message sent or received; call whenever the radio is reinitialized or a game starts
+ * Parameters:
+ * 	-*link: the link to reset
+ * 	-local: index of the local player (0 in the lobby)
+ */
+void protocolReset(struct ProtocolLink *link, uint8_t local);
+
+/* Packs a message into one radio word
+ * Parameters:
+ * 	-*message: the message (its sender and seq are used as is)
+ * Returns:
+ * 	-the radio word
+ */
+uint32_t protocolEncode(const struct Message *message);
+
+/* Unpacks a radio word
+ * Parameters:
+ * 	-word: the radio word
+ * 	-*message: filled with the decoded message
+ * Returns:
+ * 	-True if the word holds a well formed message
+ * 	-False otherwise
+ */
+bool protocolDecode(uint32_t word, struct Message *message);
+
+/* Stamps a message with the local player and the link's next sequence number and packs it
+ * Parameters:
+ * 	-*link: the link the message is sent on
+ * 	-*message: the message (its sender and seq are filled in)
+ * Returns:
+ * 	-the radio word to send
+ */
+uint32_t protocolSend(struct ProtocolLink *link, struct Message *message);
+
+/* Checks a received word against its sender's sequence: a repeat of the last message accepted from
+ * the sender is dropped, anything else is taken however far ahead or behind it is (lobby messages
+ * repeat and are taken as they come)
+ * Parameters:
+ * 	-*link: the link the word arrived on
+ * 	-word: the radio word
+ * 	-*message: filled with the decoded message
+ * Returns:
+ * 	-the message type, or MSG_NONE if the message must be ignored
+ */
+uint8_t protocolReceive(struct ProtocolLink *link, uint32_t word, struct Message *message);
+
+/* Recovers a full tick from the low bits sent in a message
+ * Parameters:
+ * 	-bits: the tick's low bits
+ * 	-near: a full tick within half the tick range of the one sent [ticks]
+ * Returns:
+ * 	-the full tick [ticks]
+ */
+uint32_t protocolTick(uint16_t bits, uint32_t near);
+
+#endif
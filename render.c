@@ -0,0 +1,290 @@
+//**************************************************
+//
+// Authors: Caleb Reiter, Alex Fanner, Chris Chu, Kao Yang
+// Description: Dirty-rectangle sprite renderer
+//
+// Sprites are placed every frame; renderFlush() compares them against what is
+// already on the screen and only redraws what changed. A sprite that slides
+// sideways only damages the columns whose pixels actually differ (for a solid
+// log moving 1 pixel that is one leading and one trailing column). Damaged
+// rectangles are merged, composed from the background tiles and the foreground
+// pixels of every sprite that overlaps them (a sprite's background color is
+// transparent) and sent to the LCD a strip at a time (strip.c).
+// Sprites are clipped to the inside of the playfield border.
+//
+//**************************************************
+
+#include "render.h"
+
+/***************************************************
+ * Structures
+ **************************************************/
+
+//rectangle of the screen that needs to be redrawn
+struct Rect {
+	int16_t x;										//x position of left edge [pixels]
+	int16_t y;										//y position of top edge [pixels]
+	int16_t w;										//width [pixels]
+	int16_t h;										//height [pixels]
+};
+
+//sprite as placed in a slot
+struct Sprite {
+	bool visible;									//if the sprite is on the screen
+	int16_t x;										//x position of left edge [pixels]
+	int16_t y;										//y position of top edge [pixels]
+	const struct Image *image;		//the sprite's image
+};
+
+/***************************************************
+ * Global Variables
+ **************************************************/
+
+static struct Sprite drawn[RENDER_MAX_SPRITES];		//sprites as they are on the screen
+static struct Sprite next[RENDER_MAX_SPRITES];		//sprites as they should be after the next flush
+static struct Rect damage[RENDER_MAX_DAMAGE];			//damaged rectangles for the current frame
+static uint8_t numDamage = 0;											//number of damaged rectangles
+
+/***************************************************
+ * Helper Functions
+ **************************************************/
+
+//inside of the playfield border, the only area sprites are drawn in
+#define CLIP_LEFT (LEFT_BORDER + 1)
+#define CLIP_TOP (TOP_BORDER + 1)
+#define CLIP_RIGHT (RIGHT_BORDER - 1)
+#define CLIP_BOTTOM (BOTTOM_BORDER - 1)
+
+/* Finds the runs of the row at a cursor into a sprite's runs (the runs of the row above when the
+ * row repeats it) and returns the cursor of the next row
+ */
+static const uint8_t *rowRuns(const uint8_t *cursor, const uint8_t **row) {
+	if (*cursor == SPRITE_ROW_REPEAT) return cursor + 1;
+	*row = cursor;
+	while (*cursor != SPRITE_ROW_END) cursor++;
+	return cursor + 1;
+}
+
+//bit n set when pixel n of a row of runs is opaque
+static uint64_t rowMask(const uint8_t *row) {
+	uint64_t mask = 0;
+	int16_t x = 0;
+	for (; *row != SPRITE_ROW_END; row++) {
+		uint8_t draw = *row & SPRITE_DRAW_MASK;
+		x += *row >> SPRITE_SKIP_SHIFT;
+		if (draw > 0) mask |= ((1ull << draw) - 1) << x;
+		x += draw;
+	}
+	return mask;
+}
+
+static bool overlaps(const struct Rect *a, const struct Rect *b) {
+	return a->x < b->x + b->w && b->x < a->x + a->w && a->y < b->y + b->h && b->y < a->y + a->h;
+}
+
+/* Composes a damaged rectangle from the background and every sprite overlapping it
+ * (lowest slot first) one strip at a time and sends each strip to the LCD
+ */
+static void drawRect(const struct Rect *rect) {
+	int16_t bandRows = STRIP_PIXELS / rect->w;
+	if (bandRows > STRIP_MAX_ROWS) bandRows = STRIP_MAX_ROWS;
+
+	for (int16_t top = rect->y; top < rect->y + rect->h; top += bandRows) {
+		int16_t rows = rect->y + rect->h - top < bandRows ? rect->y + rect->h - top : bandRows;
+		uint16_t *scratch = stripAcquire();
+
+		for (int16_t row = 0; row < rows; row++) {
+			backgroundFill(rect->x, top + row, rect->w, &scratch[row * rect->w]);
+		}
+
+		for (uint8_t slot = 0; slot < RENDER_MAX_SPRITES; slot++) {
+			const struct Sprite *sprite = &next[slot];
+			if (!sprite->visible) continue;
+
+			//intersection of the sprite with this band
+			int16_t x0 = sprite->x > rect->x ? sprite->x : rect->x;
+			int16_t x1 = sprite->x + sprite->image->width < rect->x + rect->w ? sprite->x + sprite->image->width : rect->x + rect->w;
+			int16_t y0 = sprite->y > top ? sprite->y : top;
+			int16_t y1 = sprite->y + sprite->image->height < top + rows ? sprite->y + sprite->image->height : top + rows;
+
+			if (x0 < CLIP_LEFT) x0 = CLIP_LEFT;
+			if (x1 > CLIP_RIGHT) x1 = CLIP_RIGHT;
+			if (y0 < CLIP_TOP) y0 = CLIP_TOP;
+			if (y1 > CLIP_BOTTOM) y1 = CLIP_BOTTOM;
+
+			if (x0 >= x1 || y0 >= y1) continue;
+
+			//walk the rows down to the last one inside the intersection, filling only the opaque
+			//runs and skipping transparent runs without touching the strip
+			const struct SpriteData *data = sprite->image->sprite;
+			const uint8_t *cursor = data->runs, *row = NULL;
+			for (int16_t y = sprite->y; y < y1; y++) {
+				cursor = rowRuns(cursor, &row);
+				if (y < y0) continue;
+
+				uint16_t *out = &scratch[(y - top) * rect->w];
+				int16_t x = sprite->x;
+				for (const uint8_t *run = row; *run != SPRITE_ROW_END; run++) {
+					x += *run >> SPRITE_SKIP_SHIFT;
+					int16_t length = *run & SPRITE_DRAW_MASK;
+					int16_t left = x > x0 ? x : x0;
+					int16_t right = x + length < x1 ? x + length : x1;
+					for (; left < right; left++) out[left - rect->x] = data->color;
+					x += length;
+				}
+			}
+		}
+
+		stripSubmit(rect->x, top, rect->w, rows);
+	}
+} //end drawRect()
+
+/* Adds a damaged rectangle (clipped to the inside of the border), merging it with any
+ * damage it touches when their bounding box is no larger than the two rectangles
+ */
+static void addDamage(int16_t x, int16_t y, int16_t w, int16_t h) {
+	bool merged = true;
+
+	//sprites are never drawn over the border, so nothing outside it can change
+	if (x < CLIP_LEFT) { w -= CLIP_LEFT - x; x = CLIP_LEFT; }
+	if (y < CLIP_TOP) { h -= CLIP_TOP - y; y = CLIP_TOP; }
+	if (x + w > CLIP_RIGHT) w = CLIP_RIGHT - x;
+	if (y + h > CLIP_BOTTOM) h = CLIP_BOTTOM - y;
+	if (w <= 0 || h <= 0) return;
+
+	struct Rect rect = {x, y, w, h};
+	while (merged) {
+		merged = false;
+		for (uint8_t i = 0; i < numDamage; i++) {
+			struct Rect *other = &damage[i];
+			bool touching = rect.x <= other->x + other->w && other->x <= rect.x + rect.w
+										&& rect.y <= other->y + other->h && other->y <= rect.y + rect.h;
+			if (!touching) continue;
+
+			//merge only when the bounding box does not redraw more pixels than the two rectangles
+			int16_t x0 = rect.x < other->x ? rect.x : other->x;
+			int16_t y0 = rect.y < other->y ? rect.y : other->y;
+			int16_t x1 = rect.x + rect.w > other->x + other->w ? rect.x + rect.w : other->x + other->w;
+			int16_t y1 = rect.y + rect.h > other->y + other->h ? rect.y + rect.h : other->y + other->h;
+			if ((int32_t)(x1 - x0) * (y1 - y0) > (int32_t)rect.w * rect.h + (int32_t)other->w * other->h) continue;
+
+			//replace both rectangles with their union and look for further merges
+			rect.x = x0; rect.y = y0; rect.w = x1 - x0; rect.h = y1 - y0;
+			damage[i] = damage[--numDamage];
+			merged = true;
+			break;
+		}
+	}
+
+	if (numDamage < RENDER_MAX_DAMAGE) {
+		damage[numDamage++] = rect;
+	} else {
+		//out of damage slots: draw this rectangle right away
+		drawRect(&rect);
+	}
+} //end addDamage()
+
+/* Adds the part of the old sprite's rectangle that the new sprite no longer covers */
+static void addExposed(const struct Sprite *old, const struct Sprite *now) {
+	struct Rect o = {old->x, old->y, old->image->width, old->image->height};
+	struct Rect n = {now->x, now->y, now->image->width, now->image->height};
+
+	if (!now->visible || !overlaps(&o, &n)) {
+		addDamage(o.x, o.y, o.w, o.h);
+		return;
+	}
+
+	int16_t x0 = o.x > n.x ? o.x : n.x;
+	int16_t x1 = o.x + o.w < n.x + n.w ? o.x + o.w : n.x + n.w;
+	int16_t y0 = o.y > n.y ? o.y : n.y;
+	int16_t y1 = o.y + o.h < n.y + n.h ? o.y + o.h : n.y + n.h;
+
+	addDamage(o.x, o.y, o.w, y0 - o.y);								//above the overlap
+	addDamage(o.x, y1, o.w, o.y + o.h - y1);						//below the overlap
+	addDamage(o.x, y0, x0 - o.x, y1 - y0);							//left of the overlap
+	addDamage(x1, y0, o.x + o.w - x1, y1 - y0);				//right of the overlap
+} //end addExposed()
+
+/* Adds the columns of a sprite that slid sideways whose pixels actually changed, comparing each
+ * row's opaque pixels with the same row shifted by the slide
+ */
+static void addChangedColumns(const struct Sprite *old, const struct Sprite *now) {
+	const struct Image *image = now->image;
+	int16_t shift = now->x - old->x;
+	int16_t start = -1;
+	uint64_t changedMask = 0;
+
+	//a column whose old column is off the sprite always changes, so slides of a whole row need no masks
+	if (shift > -SPRITE_MAX_WIDTH && shift < SPRITE_MAX_WIDTH) {
+		const uint8_t *cursor = image->sprite->runs, *row = NULL;
+		for (int16_t y = 0; y < image->height; y++) {
+			cursor = rowRuns(cursor, &row);
+			uint64_t mask = rowMask(row);
+			changedMask |= mask ^ (shift > 0 ? mask >> shift : mask << -shift);
+		}
+	}
+
+	for (int16_t col = 0; col <= image->width; col++) {
+		int16_t oldCol = col + shift;
+		bool changed = col < image->width
+									&& (oldCol < 0 || oldCol >= image->width || (changedMask >> col & 1));
+		if (changed && start < 0) {
+			start = col;
+		} else if (!changed && start >= 0) {
+			addDamage(now->x + start, now->y, col - start, image->height);
+			start = -1;
+		}
+	}
+} //end addChangedColumns()
+
+/***************************************************
+ * Functions
+ **************************************************/
+
+void renderReset(void) {
+	memset(drawn, 0, sizeof(drawn));
+	memset(next, 0, sizeof(next));
+
+	//redraw the whole playfield, border included, on the next flush
+	damage[0].x = LEFT_BORDER;
+	damage[0].y = TOP_BORDER;
+	damage[0].w = GAME_WIDTH;
+	damage[0].h = GAME_HEIGHT;
+	numDamage = 1;
+} //end renderReset()
+
+void renderSprite(uint8_t slot, int16_t x, int16_t y, const struct Image *image) {
+	next[slot].visible = true;
+	next[slot].x = x;
+	next[slot].y = y;
+	next[slot].image = image;
+} //end renderSprite()
+
+void renderFlush(void) {
+
+	//collect damage from every sprite that changed
+	for (uint8_t slot = 0; slot < RENDER_MAX_SPRITES; slot++) {
+		const struct Sprite *old = &drawn[slot];
+		const struct Sprite *now = &next[slot];
+
+		if (!old->visible && !now->visible) continue;
+
+		if (old->visible && now->visible && old->y == now->y && old->image == now->image) {
+			//same image on the same rows: only the exposed and changed columns need drawing
+			if (old->x == now->x) continue;
+			addExposed(old, now);
+			addChangedColumns(old, now);
+		} else {
+			if (old->visible) addExposed(old, now);
+			if (now->visible) addDamage(now->x, now->y, now->image->width, now->image->height);
+		}
+	}
+
+	//redraw the damage
+	for (uint8_t i = 0; i < numDamage; i++) {
+		drawRect(&damage[i]);
+	}
+	numDamage = 0;
+
+	memcpy(drawn, next, sizeof(drawn));
+} //end renderFlush()
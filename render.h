@@ -0,0 +1,38 @@
+//**************************************************
+//
+// Authors: Caleb Reiter, Alex Fanner, Chris Chu, Kao Yang
+// Description: Dirty-rectangle sprite renderer
+//
+//**************************************************
+
+#ifndef __RENDER_H__
+#define __RENDER_H__
+
+#include "ece210_api.h"
+#include "Images.h"
+#include "background.h"
+#include "strip.h"
+
+#define RENDER_MAX_SPRITES 32				//number of sprite slots [sprites]
+#define RENDER_MAX_DAMAGE 48				//number of damaged rectangles tracked per frame [rectangles]
+
+/* Forgets every sprite on the screen; call after the screen has been redrawn so the
+ * next flush draws every placed sprite in full
+ */
+void renderReset(void);
+
+/* Places a sprite for the current frame (sprites in higher slots are drawn on top)
+ * Parameters:
+ * 	-slot: the sprite's slot [0, RENDER_MAX_SPRITES)
+ * 	-x: x position of the sprite's left edge [pixels]
+ * 	-y: y position of the sprite's top edge [pixels]
+ * 	-*image: the sprite's image (kept by pointer, so it must stay valid; the game passes SPRITE_IMAGES entries)
+ */
+void renderSprite(uint8_t slot, int16_t x, int16_t y, const struct Image *image);
+
+/* Collects the damage caused by every sprite change since the last flush, merges
+ * overlapping damage and redraws only the damaged pixels
+ */
+void renderFlush(void);
+
+#endif
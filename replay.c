@@ -0,0 +1,311 @@
+//**************************************************
+//
+// Authors: Caleb Reiter, Alex Fanner, Chris Chu, Kao Yang
+// Description: Compact game recording and replay (recorded by the game only with REPLAY defined)
+//
+// A game follows from its seed and every player's input on every tick, so
+// that is all a log needs to play it again. Inputs stay the same for many
+// ticks in a row and change one player at a time, so a log holds runs of
+// unchanged ticks and single input changes as varints, plus the radio words
+// that arrived in between (to see what the network did around a bad tick)
+// and a checksum of the game every REPLAY_CHECK_TICKS ticks and at the end.
+// Only ticks whose inputs are all known are recorded; guesses the rollback
+// corrected never reach the log. The recorder writes into a ring buffer that
+// a task reads out while the game goes on, and a record that does not fit
+// ends the log with a mark instead of leaving a gap. The reader needs no
+// more than the bytes up to the tick it replays, and logs can follow one
+// another in one stream.
+//
+//**************************************************
+
+#include "replay.h"
+
+#ifdef REPLAY
+#include "tasks.h"
+#ifdef HOST_SIM
+#include <stdlib.h>
+#include "ece210_sim.h"
+#endif
+#endif
+
+#define REPLAY_MAGIC0 'F'						//first byte of every log
+#define REPLAY_MAGIC1 'R'						//second byte of every log
+#define REPLAY_KIND_MASK 0x03				//kind of record in a record's varint
+#define REPLAY_KIND_BITS 2					//bits of the kind below a record's value [bits]
+#define REPLAY_PLAYER_SHIFT 3				//player above the input in a REPLAY_INPUT value
+#define REPLAY_INPUT_MASK 0x07			//input in a REPLAY_INPUT value
+#define REPLAY_CHECK_END 1					//REPLAY_CHECK value at the end of the game
+#define REPLAY_CHECK_CUT 2					//REPLAY_CHECK value where the recorder ran out of room
+#define REPLAY_MAX_RECORD 9					//longest record: a 5 byte varint and a word [bytes]
+#define REPLAY_LINE_BYTES 32				//bytes per line printed over the debug UART [bytes]
+
+/***************************************************
+ * Helper Functions
+ **************************************************/
+
+static uint8_t putVarint(uint8_t *bytes, uint32_t value) {
+	uint8_t count = 0;
+	while (value >= 0x80) {
+		bytes[count++] = value | 0x80;
+		value >>= 7;
+	}
+	bytes[count++] = value;
+	return count;
+}
+
+static uint8_t putWord(uint8_t *bytes, uint32_t word) {
+	for (uint8_t i = 0; i < 4; i++) bytes[i] = word >> (8 * i);
+	return 4;
+}
+
+/* Appends bytes to the ring; a record that would not leave room for the cut mark ends the log with it instead */
+static void put(struct ReplayRecorder *recorder, const uint8_t *bytes, uint8_t count) {
+	uint16_t room = REPLAY_BUFFER - (uint16_t)(recorder->head - recorder->tail);
+	uint8_t cut[REPLAY_MAX_RECORD];
+
+	if (recorder->lost) return;
+	if (count + REPLAY_MAX_RECORD > room) {
+		count = putVarint(cut, REPLAY_CHECK_CUT << REPLAY_KIND_BITS | REPLAY_CHECK);
+		count += putWord(&cut[count], 0);
+		bytes = cut;
+		recorder->lost = true;
+	}
+	for (uint8_t i = 0; i < count; i++) {
+		recorder->buffer[recorder->head++ % REPLAY_BUFFER] = bytes[i];
+	}
+}
+
+/* Appends one record, with a word after it if word is not NULL */
+static void putRecord(struct ReplayRecorder *recorder, uint8_t kind, uint32_t value, const uint32_t *word) {
+	uint8_t bytes[REPLAY_MAX_RECORD];
+	uint8_t count = putVarint(bytes, value << REPLAY_KIND_BITS | kind);
+	if (word != NULL) count += putWord(&bytes[count], *word);
+	put(recorder, bytes, count);
+}
+
+static bool getVarint(struct ReplayReader *reader, uint32_t *value) {
+	*value = 0;
+	for (uint8_t shift = 0; shift < 35 && reader->pos < reader->size; shift += 7) {
+		uint8_t byte = reader->data[reader->pos++];
+		*value |= (uint32_t)(byte & 0x7F) << shift;
+		if (!(byte & 0x80)) return true;
+	}
+	return false;
+}
+
+static bool getWord(struct ReplayReader *reader, uint32_t *word) {
+	if (reader->size - reader->pos < 4) return false;
+	*word = 0;
+	for (uint8_t i = 0; i < 4; i++) *word |= (uint32_t)reader->data[reader->pos++] << (8 * i);
+	return true;
+}
+
+/***************************************************
+ * Functions
+ **************************************************/
+
+void replayStart(struct ReplayRecorder *recorder, uint32_t seed, uint8_t numPlayers, uint8_t difficulty) {
+	uint8_t header[REPLAY_HEADER_BYTES] = {REPLAY_MAGIC0, REPLAY_MAGIC1, REPLAY_VERSION, numPlayers, difficulty};
+	putWord(&header[5], seed);
+
+	recorder->lost = false;
+	recorder->open = true;
+	recorder->numPlayers = numPlayers;
+	recorder->tick = 0;
+	recorder->run = 0;
+	recorder->checked = 0;
+	for (uint8_t i = 0; i < GAME_MAX_PLAYERS; i++) recorder->inputs[i] = PS2_CENTER;
+	put(recorder, header, sizeof(header));
+} //end replayStart()
+
+void replayTick(struct ReplayRecorder *recorder, const uint8_t inputs[GAME_MAX_PLAYERS]) {
+	if (!recorder->open) return;
+
+	//an input change ends the run before it
+	for (uint8_t i = 0; i < recorder->numPlayers; i++) {
+		if (inputs[i] == recorder->inputs[i]) continue;
+		replayFlush(recorder);
+		putRecord(recorder, REPLAY_INPUT, i << REPLAY_PLAYER_SHIFT | inputs[i], NULL);
+		recorder->inputs[i] = inputs[i];
+	}
+	recorder->run++;
+	recorder->tick++;
+} //end replayTick()
+
+void replayRadio(struct ReplayRecorder *recorder, uint32_t word) {
+	if (!recorder->open) return;
+	replayFlush(recorder);
+	putRecord(recorder, REPLAY_RADIO, 0, &word);
+} //end replayRadio()
+
+void replayCheck(struct ReplayRecorder *recorder, const struct Game *game, bool end) {
+	uint32_t checksum;
+
+	if (!recorder->open) return;
+	checksum = replayChecksum(game);
+	replayFlush(recorder);
+	putRecord(recorder, REPLAY_CHECK, end ? REPLAY_CHECK_END : 0, &checksum);
+	recorder->checked = recorder->tick;
+	recorder->open = !end;
+} //end replayCheck()
+
+void replayFlush(struct ReplayRecorder *recorder) {
+	if (recorder->run == 0) return;
+	putRecord(recorder, REPLAY_RUN, recorder->run, NULL);
+	recorder->run = 0;
+} //end replayFlush()
+
+uint16_t replayRead(struct ReplayRecorder *recorder, uint8_t *bytes, uint16_t max) {
+	uint16_t count = 0;
+	while (count < max && recorder->tail != recorder->head) {
+		bytes[count++] = recorder->buffer[recorder->tail++ % REPLAY_BUFFER];
+	}
+	return count;
+} //end replayRead()
+
+uint32_t replayChecksum(const struct Game *game) {
+	const struct EntityStore *store = &game->entities;
+	uint32_t sum = prngHash(game->tick);
+
+	sum = prngHash(sum ^ game->rng.key);
+	sum = prngHash(sum ^ game->rng.counter);
+	for (uint8_t i = 0; i < store->count; i++) {
+		sum = prngHash(sum ^ store->xpos[i] ^ store->xfrac[i] << 8 ^ (uint32_t)store->speed[i] << 16);
+		sum = prngHash(sum ^ store->direction[i]);
+	}
+	for (uint8_t i = 0; i < game->numPlayers; i++) {
+		const struct Player *player = &game->players[i];
+		sum = prngHash(sum ^ player->xpos ^ player->xfrac << 8 ^ (uint32_t)player->ypos << 16);
+		sum = prngHash(sum ^ player->status ^ player->direction << 8 ^ player->canMove << 16 ^ (uint32_t)player->sprite << 24);
+	}
+	return sum;
+} //end replayChecksum()
+
+bool replayOpen(struct ReplayReader *reader, struct Game *game) {
+	const uint8_t *header = &reader->data[reader->pos];
+	struct Level level;
+
+	if (reader->size - reader->pos < REPLAY_HEADER_BYTES || header[0] != REPLAY_MAGIC0 || header[1] != REPLAY_MAGIC1
+			|| header[2] != REPLAY_VERSION || header[3] < 1 || header[3] > GAME_MAX_PLAYERS || header[4] >= LEVEL_DIFFICULTIES) return false;
+
+	reader->numPlayers = header[3];
+	reader->difficulty = header[4];
+	reader->pos += 5;
+	getWord(reader, &reader->seed);
+	reader->run = 0;
+	reader->radio = 0;
+	reader->checks = 0;
+	for (uint8_t i = 0; i < GAME_MAX_PLAYERS; i++) reader->inputs[i] = PS2_CENTER;
+
+	levelGenerate(&level, reader->seed, reader->difficulty);
+	gameStart(game, reader->seed, reader->numPlayers, &level);
+	return true;
+} //end replayOpen()
+
+uint8_t replayStep(struct ReplayReader *reader, struct Game *game) {
+	uint32_t tag, word;
+
+	//read records up to the next tick
+	while (reader->run == 0) {
+		if (reader->pos == reader->size) return REPLAY_CUT;
+		if (!getVarint(reader, &tag)) return REPLAY_CORRUPT;
+
+		uint32_t value = tag >> REPLAY_KIND_BITS;
+		switch (tag & REPLAY_KIND_MASK) {
+			case REPLAY_RUN:
+				if (value == 0) return REPLAY_CORRUPT;
+				reader->run = value;
+				break;
+			case REPLAY_INPUT:
+				if ((value >> REPLAY_PLAYER_SHIFT) >= reader->numPlayers || (value & REPLAY_INPUT_MASK) > PS2_RIGHT) return REPLAY_CORRUPT;
+				reader->inputs[value >> REPLAY_PLAYER_SHIFT] = value & REPLAY_INPUT_MASK;
+				break;
+			case REPLAY_RADIO:
+				if (!getWord(reader, &word)) return REPLAY_CORRUPT;
+				reader->radio++;
+				break;
+			case REPLAY_CHECK:
+				if (!getWord(reader, &word)) return REPLAY_CORRUPT;
+				if (value == REPLAY_CHECK_CUT) return REPLAY_CUT;
+				if (word != replayChecksum(game)) return REPLAY_MISMATCH;
+				reader->checks++;
+				if (value == REPLAY_CHECK_END) return REPLAY_DONE;
+				break;
+		}
+	}
+
+	gameStep(game, reader->inputs);
+	reader->run--;
+	return REPLAY_STEPPED;
+} //end replayStep()
+
+#ifdef REPLAY
+
+/***************************************************
+ * Recording the Game
+ **************************************************/
+
+static struct ReplayRecorder recording;			//the game being recorded
+
+/* Sends bytes of the log to where the board keeps it */
+static void recordWrite(const uint8_t *bytes, uint16_t count) {
+#ifdef HOST_SIM
+	simReplayWrite(bytes, count);
+#else
+	printf("replay:");
+	for (uint16_t i = 0; i < count; i++) printf(" %02x", bytes[i]);
+	printf("\n");
+#endif
+}
+
+/* Reads out everything recorded so far */
+static void recordDrain(void) {
+	uint8_t bytes[REPLAY_LINE_BYTES];
+	uint16_t count;
+	while ((count = replayRead(&recording, bytes, sizeof(bytes))) > 0) recordWrite(bytes, count);
+}
+
+static uint32_t recordTask(void) {
+	recordDrain();
+	return REPLAY_DRAIN_MS;
+}
+
+#ifdef HOST_SIM
+/* The simulated board exits from inside the HAL when its script ends: keep the ticks recorded up to then */
+static void recordExit(void) {
+	replayFlush(&recording);
+	recordDrain();
+}
+#endif
+
+void recordStart(uint32_t seed, uint8_t numPlayers, uint8_t difficulty) {
+#ifdef HOST_SIM
+	static bool registered = false;
+	if (!registered) atexit(recordExit);
+	registered = true;
+#endif
+	replayStart(&recording, seed, numPlayers, difficulty);
+	if (!taskActive(recordTask)) taskStart(recordTask, REPLAY_DRAIN_MS);
+} //end recordStart()
+
+void recordTicks(const struct Lockstep *lockstep, const struct Game *confirmed) {
+	uint8_t inputs[GAME_MAX_PLAYERS];
+
+	while (recording.tick != confirmed->tick) {
+		lockstepInputs(lockstep, recording.tick, inputs);
+		replayTick(&recording, inputs);
+	}
+	if (recording.tick - recording.checked >= REPLAY_CHECK_TICKS) replayCheck(&recording, confirmed, false);
+} //end recordTicks()
+
+void recordRadio(uint32_t word) {
+	replayRadio(&recording, word);
+} //end recordRadio()
+
+void recordEnd(const struct Lockstep *lockstep, const struct Game *confirmed) {
+	recordTicks(lockstep, confirmed);
+	replayCheck(&recording, confirmed, true);
+	recordDrain();
+} //end recordEnd()
+
+#endif
@@ -0,0 +1,176 @@
+//**************************************************
+//
+// Authors: Caleb Reiter, Alex Fanner, Chris Chu, Kao Yang
+// Description: Compact game recording and replay (recorded by the game only with REPLAY defined)
+//
+//**************************************************
+
+#ifndef __REPLAY_H__
+#define __REPLAY_H__
+
+#include "ece210_api.h"
+#include "game.h"
+#include "lockstep.h"
+
+/* A log is read front to back in one pass, and logs may follow one another in one stream:
+ * 	header: 'F', 'R', REPLAY_VERSION, number of players, difficulty, seed (4 bytes, least significant first)
+ * 	then records, each starting with a varint (7 bits per byte, least significant first, top bit set
+ * 	on every byte but the last) holding value << 2 | kind:
+ * 		REPLAY_RUN: every player keeps its input for value ticks
+ * 		REPLAY_INPUT: value is player << 3 | input, the player's input from the next tick on
+ * 		REPLAY_RADIO: a radio word arrived after the ticks so far (4 bytes follow); value is 0
+ * 		REPLAY_CHECK: checksum of the game after the ticks so far (4 bytes follow); value is 1 at the
+ * 		end of the game, 2 where the recorder ran out of room and the log stops (the checksum is then
+ * 		0), and 0 otherwise
+ * Every input starts at PS2_CENTER. A log cut off before its last check replays up to the cut.
+ */
+#define REPLAY_RUN 0								//a run of ticks with unchanged inputs
+#define REPLAY_INPUT 1							//one player's input changed
+#define REPLAY_RADIO 2							//a radio word was received
+#define REPLAY_CHECK 3							//checksum of the game
+
+#define REPLAY_VERSION 4						//version of the log format written
+#define REPLAY_HEADER_BYTES 9				//length of a log's header [bytes]
+#define REPLAY_BUFFER 512						//bytes the recorder holds until they are read out (power of two) [bytes]
+#define REPLAY_CHECK_TICKS 256			//ticks between two checksums written while the game goes on [ticks]
+#define REPLAY_DRAIN_MS 100					//time between two read outs of the game's recording [ms]
+
+#define REPLAY_STEPPED 0						//the game moved on one tick
+#define REPLAY_DONE 1								//the log ended with the game and every checksum matched
+#define REPLAY_CUT 2								//the log ended before the game did
+#define REPLAY_MISMATCH 3						//the game differs from a checksum in the log
+#define REPLAY_CORRUPT 4						//the bytes are not a log
+
+//writes a log into a ring buffer that is read out while the game goes on
+struct ReplayRecorder {
+	uint8_t buffer[REPLAY_BUFFER];								//bytes written and not read out yet
+	uint16_t head;																//bytes written (wraps, index head % REPLAY_BUFFER) [bytes]
+	uint16_t tail;																//bytes read out (wraps) [bytes]
+	bool open;																		//if a log is being written (from its start to its last checksum)
+	bool lost;																		//if a record did not fit; the log stops there until the next start
+	uint8_t numPlayers;														//number of players in the game recorded
+	uint32_t tick;																//ticks recorded [ticks]
+	uint32_t run;																	//ticks recorded but not written yet, all with the inputs last written [ticks]
+	uint32_t checked;															//tick the last checksum was written on [ticks]
+	uint8_t inputs[GAME_MAX_PLAYERS];							//every player's input as last written
+};
+
+//reads one log back out of a stream of bytes
+struct ReplayReader {
+	const uint8_t *data;													//the stream
+	uint32_t size;																//length of the stream [bytes]
+	uint32_t pos;																	//first byte not read yet (the next log once this one is done) [bytes]
+	uint8_t numPlayers;														//number of players in the game
+	uint8_t difficulty;														//difficulty of the game's lanes
+	uint32_t seed;																//seed of the game
+	uint32_t run;																	//ticks left in the current run [ticks]
+	uint32_t radio;																//radio words passed so far
+	uint32_t checks;															//checksums that matched so far
+	uint8_t inputs[GAME_MAX_PLAYERS];							//every player's current input
+};
+
+/* Starts a log; bytes of an earlier log not read out yet are kept ahead of it
+ * (the recorder must be zeroed before its first log)
+ * Parameters:
+ * 	-*recorder: the recorder
+ * 	-seed: the seed the game was started with
+ * 	-numPlayers: number of players in the game
+ * 	-difficulty: difficulty the game was started with
+ */
+void replayStart(struct ReplayRecorder *recorder, uint32_t seed, uint8_t numPlayers, uint8_t difficulty);
+
+/* Records one tick
+ * Parameters:
+ * 	-*recorder: the recorder
+ * 	-inputs: every player's input the tick was simulated with
+ */
+void replayTick(struct ReplayRecorder *recorder, const uint8_t inputs[GAME_MAX_PLAYERS]);
+
+/* Records a radio word, received after the ticks recorded so far
+ * Parameters:
+ * 	-*recorder: the recorder
+ * 	-word: the radio word
+ */
+void replayRadio(struct ReplayRecorder *recorder, uint32_t word);
+
+/* Records the checksum of the game after the ticks recorded so far
+ * Parameters:
+ * 	-*recorder: the recorder
+ * 	-*game: the game after every tick recorded
+ * 	-end: if the game is over and the log ends here
+ */
+void replayCheck(struct ReplayRecorder *recorder, const struct Game *game, bool end);
+
+/* Writes out the ticks recorded but held back to be merged with the next ones */
+void replayFlush(struct ReplayRecorder *recorder);
+
+/* Takes the oldest bytes of the log out of the recorder
+ * Parameters:
+ * 	-*recorder: the recorder
+ * 	-*bytes: filled with the bytes
+ * 	-max: most bytes to take [bytes]
+ * Returns:
+ * 	-the number of bytes taken [bytes]
+ */
+uint16_t replayRead(struct ReplayRecorder *recorder, uint8_t *bytes, uint16_t max);
+
+/* Returns a checksum of everything in a game that decides how it plays out */
+uint32_t replayChecksum(const struct Game *game);
+
+/* Reads the header of the log at the reader's position and starts its game
+ * Parameters:
+ * 	-*reader: the reader (data, size and pos must be set)
+ * 	-*game: filled with the game as it started
+ * Returns:
+ * 	-True if a log starts there
+ * 	-False otherwise
+ */
+bool replayOpen(struct ReplayReader *reader, struct Game *game);
+
+/* Replays the log up to the next tick and simulates it, checking every checksum passed on the way
+ * Parameters:
+ * 	-*reader: the reader
+ * 	-*game: the game
+ * Returns:
+ * 	-one of REPLAY_STEPPED, REPLAY_DONE, REPLAY_CUT, REPLAY_MISMATCH, REPLAY_CORRUPT
+ */
+uint8_t replayStep(struct ReplayReader *reader, struct Game *game);
+
+#ifdef REPLAY
+
+/* Starts recording a game (on the host simulator to <dump prefix><board>.rec, on the board as hex lines
+ * over the debug UART)
+ * Parameters:
+ * 	-seed: the seed the game was started with
+ * 	-numPlayers: number of players in the game
+ * 	-difficulty: difficulty the game was started with
+ */
+void recordStart(uint32_t seed, uint8_t numPlayers, uint8_t difficulty);
+
+/* Records every tick up to the last one whose inputs are all known
+ * Parameters:
+ * 	-*lockstep: every player's inputs
+ * 	-*confirmed: the game as of the last tick whose inputs are all known
+ */
+void recordTicks(const struct Lockstep *lockstep, const struct Game *confirmed);
+
+/* Records a radio word received during the game */
+void recordRadio(uint32_t word);
+
+/* Records the last ticks of a game and ends its log
+ * Parameters:
+ * 	-*lockstep: every player's inputs
+ * 	-*confirmed: the game as it ended for every player
+ */
+void recordEnd(const struct Lockstep *lockstep, const struct Game *confirmed);
+
+#else
+
+#define recordStart(seed, numPlayers, difficulty)
+#define recordTicks(lockstep, confirmed)
+#define recordRadio(word)
+#define recordEnd(lockstep, confirmed)
+
+#endif
+
+#endif
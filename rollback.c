@@ -0,0 +1,112 @@
+//**************************************************
+//
+// Authors: Caleb Reiter, Alex Fanner, Chris Chu, Kao Yang
+// Description: Rollback over predicted remote inputs
+//
+// Waiting for every other board's input before every tick makes the game only
+// as responsive as the radio. Instead a board simulates ahead on a guess
+// (each remote player keeps doing what it last did) for up to ROLLBACK_MAX
+// ticks, keeping a copy of the game from before each guessed tick. When the
+// real inputs arrive and one differs, the game goes back to the copy from the
+// first wrong tick and simulates the ticks since again. A frog depends only on
+// its own player's input, so a wrong guess only ever moves the frogs of the
+// players guessed wrong.
+//
+// Inputs only ever move the frogs: the logs and cars are where the tick puts
+// them (entitiesAt), whatever anyone pressed. So a snapshot is just the
+// players, and the whole game is kept once, as of the confirmed tick. Going
+// back moves a copy of its entities on to the tick gone back to, and a tick
+// is cheap enough to simulate all ROLLBACK_MAX again in one frame. The end of
+// the game is decided on the confirmed game only, so a guess can never end it.
+//
+//**************************************************
+
+#include "rollback.h"
+
+#define SLOT(tick) ((tick) & (ROLLBACK_MAX - 1))
+
+/***************************************************
+ * Helper Functions
+ **************************************************/
+
+/* Simulates the next tick with the best inputs known, keeping a copy of the players from before it */
+static void simulate(struct Rollback *rollback, struct Game *game, const struct Lockstep *lockstep) {
+	uint8_t slot = SLOT(game->tick);
+	memcpy(rollback->players[slot], game->players, game->numPlayers * sizeof(struct Player));
+	lockstepInputs(lockstep, game->tick, rollback->used[slot]);
+	gameStep(game, rollback->used[slot]);
+}
+
+/* Puts the game back to how it was before a tick from the confirmed one on: the players from their
+ * snapshot, the entities moved on from the confirmed game's */
+static void restore(const struct Rollback *rollback, struct Game *game, uint32_t tick) {
+	game->tick = tick;
+	memcpy(game->players, rollback->players[SLOT(tick)], game->numPlayers * sizeof(struct Player));
+	game->entities = rollback->base.entities;
+	game->lanes = rollback->base.lanes;
+	entitiesAt(&game->entities, &game->rng, tick);
+	collisionUpdate(&game->lanes, &game->entities);
+}
+
+/* Moves the confirmed tick past every tick simulated with real inputs, stopping at the end of the game,
+ * and the confirmed game along with it */
+static void confirm(struct Rollback *rollback, const struct Game *game, const struct Lockstep *lockstep) {
+	struct Game *base = &rollback->base;
+	uint32_t start = rollback->confirmed;
+
+	while (rollback->confirmed != game->tick && lockstepReady(lockstep, rollback->confirmed) && !gameOver(base)) {
+		rollback->confirmed++;
+		memcpy(base->players, rollback->confirmed == game->tick ? game->players : rollback->players[SLOT(rollback->confirmed)],
+					 game->numPlayers * sizeof(struct Player));
+	}
+	if (rollback->confirmed != start) {
+		base->tick = rollback->confirmed;
+		entitiesAt(&base->entities, &base->rng, base->tick);
+		collisionUpdate(&base->lanes, &base->entities);
+	}
+}
+
+/***************************************************
+ * Functions
+ **************************************************/
+
+void rollbackReset(struct Rollback *rollback, const struct Game *game) {
+	rollback->confirmed = game->tick;
+	rollback->base = *game;
+} //end rollbackReset()
+
+bool rollbackCanStep(const struct Rollback *rollback, const struct Game *game) {
+	return game->tick - rollback->confirmed < ROLLBACK_MAX && !gameOver(rollbackConfirmed(rollback, game));
+} //end rollbackCanStep()
+
+void rollbackStep(struct Rollback *rollback, struct Game *game, const struct Lockstep *lockstep) {
+	simulate(rollback, game, lockstep);
+	confirm(rollback, game, lockstep);
+} //end rollbackStep()
+
+uint8_t rollbackCorrect(struct Rollback *rollback, struct Game *game, const struct Lockstep *lockstep) {
+	uint32_t end = game->tick;
+	uint8_t redone = 0;
+
+	//find the first tick whose inputs are now known and differ from the ones it was simulated with
+	for (uint32_t tick = rollback->confirmed; tick != end && lockstepReady(lockstep, tick); tick++) {
+		uint8_t inputs[GAME_MAX_PLAYERS];
+		lockstepInputs(lockstep, tick, inputs);
+		if (memcmp(inputs, rollback->used[SLOT(tick)], game->numPlayers) == 0) continue;
+
+		//go back to before that tick and simulate every tick since again
+		restore(rollback, game, tick);
+		while (game->tick != end) {
+			simulate(rollback, game, lockstep);
+			redone++;
+		}
+		break;
+	}
+
+	confirm(rollback, game, lockstep);
+	return redone;
+} //end rollbackCorrect()
+
+const struct Game *rollbackConfirmed(const struct Rollback *rollback, const struct Game *game) {
+	return rollback->confirmed == game->tick ? game : &rollback->base;
+} //end rollbackConfirmed()
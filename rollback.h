@@ -0,0 +1,64 @@
+//**************************************************
+//
+// Authors: Caleb Reiter, Alex Fanner, Chris Chu, Kao Yang
+// Description: Rollback over predicted remote inputs
+//
+//**************************************************
+
+#ifndef __ROLLBACK_H__
+#define __ROLLBACK_H__
+
+#include "ece210_api.h"
+#include "game.h"
+#include "lockstep.h"
+
+#define ROLLBACK_MAX 16						//ticks the game may run ahead of the last tick whose inputs are all known (power of two) [ticks]
+
+//the ticks simulated on guessed inputs, kept so they can be simulated again
+struct Rollback {
+	uint32_t confirmed;														//every tick before this one was simulated with every player's real input [ticks]
+	uint8_t used[ROLLBACK_MAX][GAME_MAX_PLAYERS];			//inputs each tick from confirmed on was simulated with (index tick % ROLLBACK_MAX)
+	struct Player players[ROLLBACK_MAX][GAME_MAX_PLAYERS];	//the players as they were before each tick from confirmed on (index tick % ROLLBACK_MAX)
+	struct Game base;															//the game as of the confirmed tick, which the entities of every later tick are worked out from
+};
+
+/* Starts a game: nothing has been guessed yet
+ * Parameters:
+ * 	-*rollback: the rollback state
+ * 	-*game: the game, freshly started
+ */
+void rollbackReset(struct Rollback *rollback, const struct Game *game);
+
+/* Checks whether the game may simulate another tick, guessing inputs that have not arrived
+ * Parameters:
+ * 	-*rollback: the rollback state
+ * 	-*game: the game
+ * Returns:
+ * 	-True if the tick can be simulated
+ * 	-False if the game is too far ahead of the inputs known, or the game is over
+ */
+bool rollbackCanStep(const struct Rollback *rollback, const struct Game *game);
+
+/* Simulates one tick, guessing that a player whose input has not arrived keeps its last known input
+ * Parameters:
+ * 	-*rollback: the rollback state
+ * 	-*game: the game
+ * 	-*lockstep: every player's inputs
+ */
+void rollbackStep(struct Rollback *rollback, struct Game *game, const struct Lockstep *lockstep);
+
+/* Checks the guesses against the inputs that arrived since; from the first wrong guess on the game
+ * goes back to its snapshot and the ticks are simulated again
+ * Parameters:
+ * 	-*rollback: the rollback state
+ * 	-*game: the game
+ * 	-*lockstep: every player's inputs
+ * Returns:
+ * 	-the number of ticks simulated again [ticks]
+ */
+uint8_t rollbackCorrect(struct Rollback *rollback, struct Game *game, const struct Lockstep *lockstep);
+
+/* Returns the game as of the last tick whose inputs are all known, which every board agrees on */
+const struct Game *rollbackConfirmed(const struct Rollback *rollback, const struct Game *game);
+
+#endif
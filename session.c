@@ -0,0 +1,136 @@
+//**************************************************
+//
+// Authors: Caleb Reiter, Alex Fanner, Chris Chu, Kao Yang
+// Description: Lobby of the players joining a game (player table and player indexes)
+//
+// A board joins the lobby by broadcasting its player's share of the seed every
+// SESSION_REPEAT_MS, along with how many players it has heard. Every board
+// keeps the same table of players sorted by share, so a player's place in the
+// table is its index in the game and nothing has to be handed out. Two boards
+// that drew the same share both draw again; the share they dropped is no
+// longer repeated and leaves every other table after SESSION_STALE_MS, like a
+// board that left the lobby. The game starts once every player heard agrees on
+// how many players there are and the table has not changed for
+// SESSION_SETTLE_MS, long enough for every board to hear the last change.
+//
+//**************************************************
+
+#include "session.h"
+#include "clock.h"
+
+/***************************************************
+ * Helper Functions
+ **************************************************/
+
+/* Returns the index of the player holding a share, or numPlayers if none does */
+static uint8_t find(const struct Session *session, uint16_t share) {
+	uint8_t i = 0;
+	while (i < session->numPlayers && session->players[i].share != share) i++;
+	return i;
+}
+
+/* Adds a player in share order */
+static bool add(struct Session *session, uint16_t share, uint8_t heard) {
+	if (session->numPlayers == GAME_MAX_PLAYERS) return false;
+
+	uint8_t i = session->numPlayers++;
+	for (; i > 0 && session->players[i - 1].share < share; i--) {
+		session->players[i] = session->players[i - 1];
+	}
+	session->players[i].share = share;
+	session->players[i].heard = heard;
+	session->players[i].heardMs = clockMs();
+	session->changedMs = clockMs();
+	return true;
+}
+
+/* Removes a player */
+static void removeAt(struct Session *session, uint8_t index) {
+	session->numPlayers--;
+	for (uint8_t i = index; i < session->numPlayers; i++) {
+		session->players[i] = session->players[i + 1];
+	}
+	session->changedMs = clockMs();
+}
+
+/***************************************************
+ * Functions
+ **************************************************/
+
+void sessionReset(struct Session *session) {
+	session->joined = false;
+	session->share = 0;
+	session->numPlayers = 0;
+	session->changedMs = clockMs();
+} //end sessionReset()
+
+bool sessionJoin(struct Session *session, uint16_t share) {
+	if (find(session, share) != session->numPlayers) return false;
+
+	//drop the earlier share
+	if (session->joined) {
+		removeAt(session, find(session, session->share));
+		session->joined = false;
+	}
+	if (!add(session, share, 0)) return false;
+
+	session->joined = true;
+	session->share = share;
+	return true;
+} //end sessionJoin()
+
+bool sessionReceive(struct Session *session, const struct Message *message) {
+	if (session->joined && message->share == session->share) return true;
+
+	uint8_t i = find(session, message->share);
+	if (i == session->numPlayers) {
+		add(session, message->share, message->heard);
+	} else {
+		session->players[i].heard = message->heard;
+		session->players[i].heardMs = clockMs();
+	}
+	return false;
+} //end sessionReceive()
+
+void sessionUpdate(struct Session *session) {
+	uint32_t now = clockMs();
+
+	for (uint8_t i = 0; i < session->numPlayers; i++) {
+		struct SessionPlayer *player = &session->players[i];
+
+		//the local player is always there and always agrees with itself
+		if (session->joined && player->share == session->share) {
+			player->heard = session->numPlayers;
+			player->heardMs = now;
+		} else if (now - player->heardMs > SESSION_STALE_MS) {
+			removeAt(session, i--);
+		}
+	}
+} //end sessionUpdate()
+
+bool sessionReady(const struct Session *session) {
+	if (!session->joined || session->numPlayers < 2 || clockMs() - session->changedMs < SESSION_SETTLE_MS) return false;
+
+	for (uint8_t i = 0; i < session->numPlayers; i++) {
+		if (session->players[i].heard != session->numPlayers) return false;
+	}
+	return true;
+} //end sessionReady()
+
+void sessionMessage(const struct Session *session, struct Message *message) {
+	message->type = MSG_READY;
+	message->heard = session->numPlayers;
+	message->share = session->share;
+} //end sessionMessage()
+
+uint8_t sessionLocal(const struct Session *session) {
+	return find(session, session->share);
+} //end sessionLocal()
+
+uint32_t sessionSeed(const struct Session *session) {
+	uint32_t seed = 0;
+	for (uint8_t i = 0; i < session->numPlayers; i++) {
+		seed = ((seed << 16) | (seed >> 16)) ^ session->players[i].share;
+	}
+	return seed;
+} //end sessionSeed()
@@ -0,0 +1,90 @@
+//**************************************************
+//
+// Authors: Caleb Reiter, Alex Fanner, Chris Chu, Kao Yang
+// Description: Lobby of the players joining a game (player table and player indexes)
+//
+//**************************************************
+
+#ifndef __SESSION_H__
+#define __SESSION_H__
+
+#include "ece210_api.h"
+#include "game.h"
+#include "protocol.h"
+
+#define SESSION_REPEAT_MS 250			//time between two ready messages of a board in the lobby [ms]
+#define SESSION_STALE_MS 1000			//a player not heard from for this long has left the lobby [ms]
+#define SESSION_SETTLE_MS 1500		//time the lobby must stay the same, with every player agreeing on its size, before the game starts [ms]
+
+//player in the lobby
+struct SessionPlayer {
+	uint16_t share;								//the player's share of the game's seed, which also tells the players apart
+	uint8_t heard;								//number of players the player last said it had heard
+	uint32_t heardMs;							//time the player was last heard from [ms]
+};
+
+//every player ready to play, as heard by this board
+struct Session {
+	bool joined;																		//if the local player is ready
+	uint16_t share;																	//the local player's share of the game's seed
+	uint8_t numPlayers;															//number of players ready, the local player included
+	uint32_t changedMs;															//time a player last joined or left [ms]
+	struct SessionPlayer players[GAME_MAX_PLAYERS];	//every player ready, largest share first (a player's index in the game)
+};
+
+/* Empties the lobby
+ * Parameters:
+ * 	-*session: the session
+ */
+void sessionReset(struct Session *session);
+
+/* Makes the local player ready, replacing its earlier share if it had one
+ * Parameters:
+ * 	-*session: the session
+ * 	-share: the local player's share of the game's seed
+ * Returns:
+ * 	-True if the player joined
+ * 	-False if another player already holds that share (draw another one) or the lobby is full
+ */
+bool sessionJoin(struct Session *session, uint16_t share);
+
+/* Takes in another board's ready message
+ * Parameters:
+ * 	-*session: the session
+ * 	-*message: a MSG_READY message
+ * Returns:
+ * 	-True if that player holds the local player's share; both boards must join again with new shares
+ * 	-False otherwise
+ */
+bool sessionReceive(struct Session *session, const struct Message *message);
+
+/* Forgets the players that left the lobby; call on every pass of the lobby loop
+ * Parameters:
+ * 	-*session: the session
+ */
+void sessionUpdate(struct Session *session);
+
+/* Checks whether the game can start: the local player is ready, every player heard agrees on the
+ * number of players, and none joined or left for SESSION_SETTLE_MS
+ * Parameters:
+ * 	-*session: the session
+ * Returns:
+ * 	-True if the game starts
+ * 	-False otherwise
+ */
+bool sessionReady(const struct Session *session);
+
+/* Builds the local player's ready message
+ * Parameters:
+ * 	-*session: the session
+ * 	-*message: filled with a MSG_READY message
+ */
+void sessionMessage(const struct Session *session, struct Message *message);
+
+/* Returns the index of the local player in the game (only valid once the local player joined) */
+uint8_t sessionLocal(const struct Session *session);
+
+/* Returns the game's seed, which is made of every player's share in player order */
+uint32_t sessionSeed(const struct Session *session);
+
+#endif
@@ -0,0 +1,89 @@
+//**************************************************
+//
+// Authors: Caleb Reiter, Alex Fanner, Chris Chu, Kao Yang
+// Description: Pixel strip composed in RAM and flushed to the LCD
+//
+// The renderer composes a damaged band into the strip, then sends it. The LCD
+// bus belongs to the board library and is only reachable through its drawing
+// calls, which drive it from the CPU, so a strip is sent as column bands of at
+// most two colors (one image or rectangle write each) and the send finishes
+// before stripSubmit() returns. Nothing can be composed while a strip is being
+// sent, so a second strip would only cost RAM.
+//
+//**************************************************
+
+#include "strip.h"
+
+/***************************************************
+ * Global Variables
+ **************************************************/
+
+static uint16_t strip[STRIP_PIXELS];														//strip buffer
+static uint8_t packed[STRIP_PIXELS / 8 + STRIP_MAX_ROWS];				//column band packed to 1 bit
+
+/***************************************************
+ * Helper Functions
+ **************************************************/
+
+/* Pushes composed pixels to the LCD, split into column bands that use at most two colors
+ * so each band is a single image (or rectangle) write
+ */
+static void pushPixels(int16_t x, int16_t y, int16_t w, int16_t h, const uint16_t *pixels) {
+	int16_t start = 0;
+
+	while (start < w) {
+		uint16_t a = pixels[start], b = a;
+		int16_t end = start;
+
+		//grow the band one column at a time while it still fits in two colors
+		for (; end < w; end++) {
+			uint16_t colB = b;
+			bool fits = true;
+			for (int16_t row = 0; row < h && fits; row++) {
+				uint16_t p = pixels[row * w + end];
+				if (p == a || p == colB) continue;
+				if (colB == a) colB = p; else fits = false;
+			}
+			if (!fits) break;
+			b = colB;
+		}
+
+		if (end == start) {
+			//a single column with more than two colors: write it as vertical runs
+			int16_t row = 0;
+			while (row < h) {
+				int16_t run = row + 1;
+				while (run < h && pixels[run * w + start] == pixels[row * w + start]) run++;
+				ece210_lcd_draw_rectangle(x + start, 1, y + row, run - row, pixels[row * w + start]);
+				row = run;
+			}
+			start++;
+		} else if (a == b) {
+			ece210_lcd_draw_rectangle(x + start, end - start, y, h, a);
+			start = end;
+		} else {
+			int16_t bandWidth = end - start;
+			int16_t bytesPerRow = (bandWidth + 7) / 8;
+			memset(packed, 0, bytesPerRow * h);
+			for (int16_t row = 0; row < h; row++) {
+				for (int16_t col = 0; col < bandWidth; col++) {
+					if (pixels[row * w + start + col] == a) packed[row * bytesPerRow + col / 8] |= 0x80 >> (col % 8);
+				}
+			}
+			ece210_lcd_draw_image(x + start, bandWidth, y, h, packed, a, b);
+			start = end;
+		}
+	}
+} //end pushPixels()
+
+/***************************************************
+ * Functions
+ **************************************************/
+
+uint16_t *stripAcquire(void) {
+	return strip;
+} //end stripAcquire()
+
+void stripSubmit(int16_t x, int16_t y, int16_t w, int16_t h) {
+	pushPixels(x, y, w, h, strip);
+} //end stripSubmit()
@@ -0,0 +1,31 @@
+//**************************************************
+//
+// Authors: Caleb Reiter, Alex Fanner, Chris Chu, Kao Yang
+// Description: Pixel strip composed in RAM and flushed to the LCD
+//
+//**************************************************
+
+#ifndef __STRIP_H__
+#define __STRIP_H__
+
+#include "ece210_api.h"
+
+#define STRIP_PIXELS 1024						//size of one strip buffer [pixels]
+#define STRIP_MAX_ROWS 32						//maximum rows in one strip [rows]
+
+/* Returns the strip buffer to compose into (the last strip submitted has been sent already)
+ * Returns:
+ * 	-STRIP_PIXELS RGB565 pixels to fill in row-major order
+ */
+uint16_t *stripAcquire(void);
+
+/* Sends the strip returned by the last stripAcquire() to the LCD, returning once it is sent
+ * Parameters:
+ * 	-x: x position of the strip's left edge [pixels]
+ * 	-y: y position of the strip's top edge [pixels]
+ * 	-w: width of the strip [pixels]
+ * 	-h: height of the strip [rows] (w * h <= STRIP_PIXELS, h <= STRIP_MAX_ROWS)
+ */
+void stripSubmit(int16_t x, int16_t y, int16_t w, int16_t h);
+
+#endif
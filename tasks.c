@@ -0,0 +1,84 @@
+//**************************************************
+//
+// Authors: Caleb Reiter, Alex Fanner, Chris Chu, Kao Yang
+// Description: Cooperative scheduler of timed tasks
+//
+// Everything the board does while the game goes on (polling the radio,
+// stepping the game, counting down, animating the LEDs) is a task: a state
+// machine that does one short step and says how long until its next one.
+// Nothing waits inside a step, so a task that is due is never held up by more
+// than the other steps due at the same time, and the board sleeps until the
+// earliest task is due instead of spinning.
+//
+//**************************************************
+
+#include "tasks.h"
+
+/***************************************************
+ * Global Variables
+ **************************************************/
+
+static struct Task tasks[TASKS_MAX];			//scheduled tasks, each in the first slot free when it started
+
+/***************************************************
+ * Helper Functions
+ **************************************************/
+
+static struct Task *find(TaskStep step) {
+	for (uint8_t i = 0; i < TASKS_MAX; i++) {
+		if (tasks[i].step == step) return &tasks[i];
+	}
+	return NULL;
+}
+
+/***************************************************
+ * Functions
+ **************************************************/
+
+bool taskStart(TaskStep step, uint32_t delayMs) {
+	struct Task *task = find(step);
+	if (task == NULL) task = find(NULL);
+	if (task == NULL) return false;
+
+	task->step = step;
+	task->dueMs = clockMs() + delayMs;
+	return true;
+} //end taskStart()
+
+void taskStop(TaskStep step) {
+	struct Task *task = find(step);
+	if (task != NULL) task->step = NULL;
+} //end taskStop()
+
+bool taskActive(TaskStep step) {
+	return step != NULL && find(step) != NULL;
+} //end taskActive()
+
+void tasksRun(void) {
+	bool scheduled = false;
+	uint32_t dueMs = 0;
+
+	//sleep until the earliest step is due
+	for (uint8_t i = 0; i < TASKS_MAX; i++) {
+		if (tasks[i].step == NULL) continue;
+		if (!scheduled || (int32_t)(tasks[i].dueMs - dueMs) < 0) dueMs = tasks[i].dueMs;
+		scheduled = true;
+	}
+	if (!scheduled) return;
+	clockWaitUntil(dueMs);
+
+	//run every step that is due; a step may start or stop tasks, including its own
+	for (uint8_t i = 0; i < TASKS_MAX; i++) {
+		struct Task *task = &tasks[i];
+		TaskStep step = task->step;
+		if (step == NULL || (int32_t)(clockMs() - task->dueMs) < 0) continue;
+
+		uint32_t delayMs = step();
+		if (task->step != step) continue;
+		if (delayMs == TASK_DONE) {
+			task->step = NULL;
+		} else {
+			task->dueMs = clockMs() + delayMs;
+		}
+	}
+} //end tasksRun()
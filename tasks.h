@@ -0,0 +1,60 @@
+//**************************************************
+//
+// Authors: Caleb Reiter, Alex Fanner, Chris Chu, Kao Yang
+// Description: Cooperative scheduler of timed tasks
+//
+//**************************************************
+
+#ifndef __TASKS_H__
+#define __TASKS_H__
+
+#include "ece210_api.h"
+#include "clock.h"
+
+#define TASKS_MAX 8									//tasks that can be scheduled at once [tasks]
+#define TASK_DONE 0xFFFFFFFF				//returned by a task that is finished and must not run again
+
+/* A task does one short step of its work and returns right away
+ * Returns:
+ * 	-the time until the task's next step [ms], or TASK_DONE
+ */
+typedef uint32_t (*TaskStep)(void);
+
+//task waiting for its next step
+struct Task {
+	TaskStep step;								//the task's step function (NULL if the slot is free)
+	uint32_t dueMs;								//time the next step is due [ms]
+};
+
+/* Schedules a task's first step; a task that is already scheduled is moved to the new time instead
+ * Parameters:
+ * 	-step: the task's step function
+ * 	-delayMs: time until the first step [ms]
+ * Returns:
+ * 	-True if the task is scheduled
+ * 	-False if every slot is taken
+ */
+bool taskStart(TaskStep step, uint32_t delayMs);
+
+/* Removes a task so it takes no more steps (nothing happens if it is not scheduled)
+ * Parameters:
+ * 	-step: the task's step function
+ */
+void taskStop(TaskStep step);
+
+/* Checks if a task is scheduled
+ * Parameters:
+ * 	-step: the task's step function
+ * Returns:
+ * 	-True if the task will take another step
+ * 	-False otherwise
+ */
+bool taskActive(TaskStep step);
+
+/* Sleeps until the earliest task is due, then runs one step of every task that is due (in slot
+ * order, and taskStart() takes the first free slot, so a task started later can run before an
+ * earlier one); returns right away if no task is scheduled
+ */
+void tasksRun(void);
+
+#endif